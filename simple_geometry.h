@@ -23,6 +23,13 @@ extern "C" {
 #ifndef SG_GIZMO_CIRCLE_SUBDIVISIONS
 #define SG_GIZMO_CIRCLE_SUBDIVISIONS 128
 #endif
+
+/* Largest subdivision count for which ring based generators tabulate the
+ * unit circle, beyond it they fall back to evaluating SG_COS & SG_SIN.
+ */
+#ifndef SG_RING_TABLE_CAPACITY
+#define SG_RING_TABLE_CAPACITY 512
+#endif
 	
 /** @addtogroup status
  *  @{
@@ -41,6 +48,12 @@ enum sg_status {
 	SG_ERR_SRCBLKSIZE_LESSTHAN_SRCSTRIDE,
 	SG_ERR_SRCBLKSIZE_LESSTHAN_DSTSTRIDE,
 	SG_ERR_VERTICES_NOT_DIVISIBLE_BY_3,
+	SG_ERR_INVALID_VERTEX_FORMAT,
+	SG_ERR_ALLOCATION_FAILED,
+	SG_ERR_INVALID_RANGE,
+	SG_ERR_INVALID_TILE_SIZE,
+	SG_ERR_BUFFER_FULL,
+	SG_ERR_UNALIGNED_VERTEX_ATTRIBUTE,
 
 	SG_ERR_NOT_IMPLEMENTED_YET,
 };
@@ -69,12 +82,16 @@ sg_status_string(const enum sg_status status);
 	
 
 /**
- * @brief Convert a status code into a string literal.
+ * @brief Copy a block of bytes from one buffer to another.
  *
  * @param[in] src source pointer to copy bytes from.
  * @param[in] n bytecount to copy from 'src'.
  * @param[out] dst destination pointer to copy 'n' bytes to.
  *
+ * @note The copy is done in vector sized chunks when SSE2, AVX2 or NEON is
+ *       enabled for the target, and in word sized chunks otherwise.
+ *       'src' and 'dst' must not overlap.
+ *
  * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
@@ -93,11 +110,14 @@ struct sg_strided_blockcopy_source_info {
 };
 
 /**
- * @brief Convert a status code into a string literal.
+ * @brief Copy strided blocks of memory into a buffer with another stride.
  *
- * @param[in] src source pointer to copy bytes from.
- * @param[in] n bytecount to copy from 'src'.
- * @param[out] dst destination pointer to copy 'n' bytes to.
+ * @param[in] source information describing the blocks to copy.
+ * @param[in] stride stride between the copied blocks in 'dst'.
+ * @param[out] dst destination pointer to copy the first block to.
+ *
+ * @note Block sizes of 4, 8, 12 & 16 bytes use fixed size copy kernels,
+ *       and fully packed sources and destinations are copied in one go.
  *
  * @return status code describing the result of evaluation.
  */
@@ -108,7 +128,43 @@ sg_strided_blockcopy(
 	const size_t stride,
 	void* dst
 );
-	
+
+#ifndef SG_INTERLEAVE_TILE_SIZE
+#define SG_INTERLEAVE_TILE_SIZE 8192
+#endif
+
+struct sg_interleave_source_info {
+	const void* ptr;    /// source pointer to first block.
+	size_t block_size;  /// memory size of blocks.
+	size_t stride;      /// stride of the individual blocks.
+	size_t offset;      /// offset of the blocks inside each destination element.
+};
+
+/**
+ * @brief Interleave multiple strided sources into a single buffer.
+ *
+ * @param[in] sources information describing each of the sources to copy.
+ * @param[in] source_count amount of sources in 'sources'.
+ * @param[in] block_count amount of blocks to copy from each source.
+ * @param[in] stride stride between the elements in 'dst'.
+ * @param[out] dst destination pointer to the first element.
+ *
+ * @note The destination is written in tiles of around SG_INTERLEAVE_TILE_SIZE
+ *       bytes, copying every source into a tile before moving on to the next,
+ *       so each destination element is only pulled into the cache once.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_interleave(
+	struct sg_interleave_source_info const* sources,
+	const size_t source_count,
+	const size_t block_count,
+	const size_t stride,
+	void* dst
+);
+
 /** @}*/
 	
 
@@ -119,6 +175,9 @@ sg_strided_blockcopy(
 #ifndef	SG_indice
 #  define SG_indice uint32_t
 #endif
+
+/* Largest value of the unsigned SG_indice type. */
+#define SG_INDICE_MAX ((SG_indice)~(SG_indice)0)
 	
 struct sg_position {
 	float x;
@@ -137,6 +196,98 @@ struct sg_normal {
 	float z;
 };
 
+enum sg_vertex_format {
+	SG_VERTEX_FORMAT_NONE,    /// attribute is not generated.
+	SG_VERTEX_FORMAT_FLOAT32, /// 32bit float components.
+	SG_VERTEX_FORMAT_SNORM16, /// normalized signed 16bit components, normals only.
+	SG_VERTEX_FORMAT_UNORM16, /// normalized unsigned 16bit components, texcoords only.
+};
+
+struct sg_vertex_attribute {
+	enum sg_vertex_format format; /// component format of the attribute.
+	size_t offset;                /// byte offset of the first attribute in the buffer.
+	size_t stride;                /// byte stride between consecutive attributes.
+};
+
+/**
+ * Description of a caller owned vertex buffer that generators write into.
+ * An interleaved buffer shares one stride across the attributes and uses the
+ * offsets inside the vertex, while separate attribute regions of the same
+ * buffer each have their own offset and stride.
+ *
+ * Attributes are written through their component type, so the address of
+ * every attribute must be aligned to its component size: 4 bytes for float32
+ * and 2 bytes for the 16bit formats. Generators return
+ * SG_ERR_UNALIGNED_VERTEX_ATTRIBUTE for an attribute whose buffer address,
+ * offset or stride breaks this.
+ */
+struct sg_vertex_layout {
+	void* buffer;                        /// buffer to write the vertices to.
+	struct sg_vertex_attribute position; /// layout of the vertex positions.
+	struct sg_vertex_attribute normal;   /// layout of the vertex normals.
+	struct sg_vertex_attribute texcoord; /// layout of the vertex texcoords.
+};
+
+/** @}*/
+	
+
+/** @addtogroup allocation
+ *  @{
+ */
+
+#ifndef	SIMPLE_GEOMETRY_DONT_INCLUDE_STDLIB_H
+#  include <stdlib.h>
+#  define SG_MALLOC(SIZE) malloc(SIZE)
+#  define SG_FREE(PTR) free(PTR)
+#endif
+
+struct sg_allocator {
+	void* (*alloc)(size_t size, void* user);        /// allocate 'size' bytes, NULL on failure.
+	void (*free)(void* ptr, size_t size, void* user); /// release memory returned by 'alloc'.
+	void* user;                                     /// user pointer passed to the callbacks.
+};
+
+#ifdef SG_MALLOC
+/**
+ * @brief get an allocator using SG_MALLOC & SG_FREE.
+ * @return the allocator.
+ */
+SG_API_EXPORT
+struct sg_allocator
+sg_default_allocator();
+#endif
+
+enum sg_attribute {
+	SG_ATTRIBUTE_POSITION = 1 << 0, /// generate vertex positions.
+	SG_ATTRIBUTE_NORMAL   = 1 << 1, /// generate vertex normals.
+	SG_ATTRIBUTE_TEXCOORD = 1 << 2, /// generate vertex texcoords.
+	SG_ATTRIBUTE_ALL      = SG_ATTRIBUTE_POSITION | SG_ATTRIBUTE_NORMAL | SG_ATTRIBUTE_TEXCOORD,
+};
+
+struct sg_mesh {
+	struct sg_position* positions; /// generated vertex positions, or NULL.
+	struct sg_normal* normals;     /// generated vertex normals, or NULL.
+	struct sg_texcoord* texcoords; /// generated vertex texcoords, or NULL.
+	size_t vertices_length;        /// length of the vertex buffers.
+	SG_indice* indices;            /// generated indices, NULL for non-indexed geometry.
+	size_t indices_length;         /// length of the index buffer.
+};
+
+/**
+ * @brief Release the buffers of a generated mesh.
+ *
+ * @param[in]     allocator The allocator the mesh was generated with.
+ * @param[in out] mesh      The mesh to release, it is reset to be empty.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_mesh_free(
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+);
+
 /** @}*/
 	
 
@@ -148,6 +299,7 @@ struct sg_indexed_plane_info {
 	float depth;               /// depth of the plane.
 	size_t width_subdivisions; /// subdivisions along the width of the plane.
 	size_t depth_subdivisions; /// subdivisions along the depth of the plane.
+	size_t cache_size;         /// post-transform vertex cache size to order indices for, 0 for plain row order.
 };
 	
 /**
@@ -169,6 +321,11 @@ struct sg_indexed_plane_info {
  * @note If any of the output vertex buffers are provided as NULL, the
  *       associated vertex data will not be generated and returned. 
  *
+ * @note The plane is a row-major grid of 'width_subdivisions' by
+ *       'depth_subdivisions' vertices spanning [0, width] x [0, depth] in
+ *       the xy plane, facing +z, with texcoords spanning [0, 1] x [0, 1].
+ *       Both subdivisions must be at-least 2.
+ *
  * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
@@ -180,6 +337,61 @@ sg_indexed_plane_vertices(
 	struct sg_normal* normals,
 	struct sg_texcoord* texcoords
 );
+
+/**
+ * @brief Generate vertices for a indexed & subdivided plane into a described vertex layout.
+ *
+ * @param[in]     plane     Information describing the geometry to generate.
+ * @param[in out] length    The length of required vertex buffer to supply.
+ * @param[in]     layout    Layout of the vertex buffer to generate into.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside a NULL 'layout' or
+ *       layout buffer.
+ *
+ * @note The layout buffer MUST be large enough to hold 'length' vertices
+ *       for every attribute with a format other than SG_VERTEX_FORMAT_NONE.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_plane_vertices_layout(
+	struct sg_indexed_plane_info const* plane,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+);
+
+/**
+ * @brief Generate a range of vertex rows for a indexed & subdivided plane.
+ *
+ * @param[in]  plane     Information describing the geometry to generate.
+ * @param[in]  first_row First vertex row to generate.
+ * @param[in]  last_row  One past the last vertex row to generate, at most 'depth_subdivisions'.
+ * @param[out] positions Vertex positions to generate.
+ * @param[out] normals   Vertex normals to generate.
+ * @param[out] texcoords Vertex texcoords to generate.
+ *
+ * @note The output vertex buffers are the full buffers described by
+ *       sg_indexed_plane_vertices(), only the vertices of the rows in
+ *       [first_row, last_row) are written, at their usual offsets.
+ *       Disjoint ranges can be generated concurrently.
+ *
+ * @note If any of the output vertex buffers are provided as NULL, the
+ *       associated vertex data will not be generated and returned. 
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_plane_vertices_range(
+	struct sg_indexed_plane_info const* plane,
+	const size_t first_row,
+	const size_t last_row,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+);
 	
 /**
  * @brief Generate indices for a indexed & subdivided plane.
@@ -195,6 +407,18 @@ sg_indexed_plane_vertices(
  * @note The output index buffer MUST be provided with a length of at-least
  *       the returned 'length'.
  *
+ * @note The plane is a grid of 'width_subdivisions' by 'depth_subdivisions'
+ *       vertices, where vertex (w, d) is found at 'd * width_subdivisions + w'.
+ *       Both subdivisions must be at-least 2.
+ *
+ * @note With a non-zero 'cache_size', the grid is emitted in vertical strips
+ *       narrow enough for a row of the strip to stay in a FIFO vertex cache
+ *       of that size, which brings the ACMR close to 0.5 on large grids.
+ *       Otherwise triangles are emitted row by row.
+ *
+ * @note Returns SG_ERR_INVALID_RANGE when the last vertex of the grid does
+ *       not fit an SG_indice, for the length query as well.
+ *
  * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
@@ -205,29 +429,129 @@ sg_indexed_plane_indices(
 	SG_indice* indices
 );
 
-struct sg_cube_info {
-	float width;  /// width of the cube.
-	float height; /// height of the cube.
-	float depth;  /// depth of the cube.
+/**
+ * @brief Generate a range of index rows for a indexed & subdivided plane.
+ *
+ * @param[in]  plane     Information describing the geometry to generate.
+ * @param[in]  first_row First row of quads to generate.
+ * @param[in]  last_row  One past the last row of quads to generate, at most 'depth_subdivisions - 1'.
+ * @param[out] indices   Vertex indices to generate.
+ *
+ * @note The output index buffer is the full buffer described by
+ *       sg_indexed_plane_indices(), only the indices of the quads in
+ *       rows [first_row, last_row) are written, at their usual offsets.
+ *       Disjoint ranges can be generated concurrently.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_plane_indices_range(
+	struct sg_indexed_plane_info const* plane,
+	const size_t first_row,
+	const size_t last_row,
+	SG_indice* indices
+);
+
+#ifdef SIMPLE_GEOMETRY_USE_PTHREADS
+/**
+ * @brief Generate vertices for a indexed & subdivided plane using multiple threads.
+ *
+ * @param[in]     plane        Information describing the geometry to generate.
+ * @param[in]     thread_count Amount of threads to split the rows across.
+ * @param[in out] length       The length of required vertex buffers to supply.
+ * @param[out]    positions    Vertex positions to generate.
+ * @param[out]    normals      Vertex normals to generate.
+ * @param[out]    texcoords    Vertex texcoords to generate.
+ *
+ * @note Behaves like sg_indexed_plane_vertices(), the calling thread
+ *       generates one of the row ranges itself. Only available when
+ *       SIMPLE_GEOMETRY_USE_PTHREADS is defined.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_plane_vertices_parallel(
+	struct sg_indexed_plane_info const* plane,
+	const size_t thread_count,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+);
+
+/**
+ * @brief Generate indices for a indexed & subdivided plane using multiple threads.
+ *
+ * @param[in]     plane        Information describing the geometry to generate.
+ * @param[in]     thread_count Amount of threads to split the quad rows across.
+ * @param[in out] length       The length of required index buffer to supply.
+ * @param[out]    indices      Vertex indices to generate.
+ *
+ * @note Behaves like sg_indexed_plane_indices(), the calling thread
+ *       generates one of the row ranges itself. Only available when
+ *       SIMPLE_GEOMETRY_USE_PTHREADS is defined.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_plane_indices_parallel(
+	struct sg_indexed_plane_info const* plane,
+	const size_t thread_count,
+	size_t* length,
+	SG_indice* indices
+);
+#endif
+
+/**
+ * @brief Allocate and generate the vertices & indices of a indexed & subdivided plane in a single call.
+ *
+ * @param[in]  plane      Information describing the geometry to generate.
+ * @param[in]  attributes Bitmask of sg_attribute's to generate.
+ * @param[in]  allocator  Allocator used for the generated buffers.
+ * @param[out] mesh       The generated buffers and their lengths.
+ *
+ * @note The generated buffers are released with sg_mesh_free().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_plane_generate(
+	struct sg_indexed_plane_info const* plane,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+);
+
+struct sg_heightfield_info {
+	struct sg_indexed_plane_info plane; /// grid the heights are sampled on.
+	const float* heights;               /// row-major height samples, one per plane vertex, can be NULL when 'sample' is provided.
+	float (*sample)(size_t w, size_t d, void* user); /// height of vertex (w, d), used when 'heights' is NULL.
+	void* user;                         /// user pointer passed to 'sample'.
+	float height_scale;                 /// scale applied to the height samples.
 };
-	
 
 /**
- * @brief Generate vertices for a cube.
+ * @brief Generate vertices for a plane displaced by a heightfield.
  *
- * @param[in]     cube      Information describing the geometry to generate.
- * @param[in out] length    The length of required vertex buffers to supply.
- * @param[out]    positions Vertex positions to generate.
- * @param[out]    normals   Vertex normals to generate.
- * @param[out]    texcoords Vertex texcoords to generate.
+ * @param[in]     heightfield Information describing the geometry to generate.
+ * @param[in out] length      The length of required vertex buffers to supply.
+ * @param[out]    positions   Vertex positions to generate.
+ * @param[out]    normals     Vertex normals to generate.
+ * @param[out]    texcoords   Vertex texcoords to generate.
+ *
+ * @note The vertices are the ones of sg_indexed_plane_vertices(), displaced
+ *       along +z by the scaled height samples, with normals computed from
+ *       central differences of the heights in the same pass.
+ *       The plane indices from sg_indexed_plane_indices() apply as is.
  *
  * @note To get the required length for the returned vertex buffers,
  *       provide a pointer to 'length' alongside all vertex buffer 
  *       pointers being NULL.
  *
- * @note The output vertex buffers MUST be provided with a length of at-least
- *       the returned 'length'.
- *
  * @note If any of the output vertex buffers are provided as NULL, the
  *       associated vertex data will not be generated and returned. 
  *
@@ -235,46 +559,87 @@ struct sg_cube_info {
  */
 SG_API_EXPORT
 enum sg_status
-sg_cube_vertices(
-	struct sg_cube_info* cube,
+sg_heightfield_vertices(
+	struct sg_heightfield_info const* heightfield,
 	size_t* length,
 	struct sg_position* positions,
 	struct sg_normal* normals,
 	struct sg_texcoord* texcoords
 );
-	
-	
-struct sg_indexed_sphere_info {
-	float radius;  /// Radius of the sphere.
-	size_t slices; /// Subdivisions along the xy axis of the sphere.
-	size_t stacks; /// Subdivisions along the z axis of the sphere.
+
+/**
+ * @brief Generate vertices for a plane displaced by a heightfield into a described vertex layout.
+ *
+ * @param[in]     heightfield Information describing the geometry to generate.
+ * @param[in out] length      The length of required vertex buffer to supply.
+ * @param[in]     layout      Layout of the vertex buffer to generate into.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside a NULL 'layout' or
+ *       layout buffer.
+ *
+ * @note The layout buffer MUST be large enough to hold 'length' vertices
+ *       for every attribute with a format other than SG_VERTEX_FORMAT_NONE.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_heightfield_vertices_layout(
+	struct sg_heightfield_info const* heightfield,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+);
+
+enum sg_tile_edge {
+	SG_TILE_EDGE_WEST  = 1 << 0, /// edge along -x.
+	SG_TILE_EDGE_EAST  = 1 << 1, /// edge along +x.
+	SG_TILE_EDGE_SOUTH = 1 << 2, /// edge along -y.
+	SG_TILE_EDGE_NORTH = 1 << 3, /// edge along +y.
+};
+
+struct sg_terrain_tile_info {
+	struct sg_heightfield_info const* heightfield; /// terrain the tile is cut from.
+	size_t tile_size;          /// quads along each side of a tile at lod 0.
+	size_t tile_x;             /// column of the tile, along +x.
+	size_t tile_y;             /// row of the tile, along +y.
+	size_t lod;                /// level of detail, every level skips every other vertex.
+	unsigned int stitch_edges; /// bitmask of sg_tile_edge's bordering a tile one lod coarser.
+	float skirt_depth;         /// depth of skirts hanging below the tile edges, 0 for no skirts.
 };
 
 /**
- * @brief Generate vertices for a indexed & subdivided uv sphere.
+ * @brief Generate vertices for a single tile of a heightfield.
  *
- * @param[in]     sphere    Information describing the geometry to generate.
+ * @param[in]     tile      Information describing the geometry to generate.
  * @param[in out] length    The length of required vertex buffers to supply.
  * @param[out]    positions Vertex positions to generate.
  * @param[out]    normals   Vertex normals to generate.
  * @param[out]    texcoords Vertex texcoords to generate.
  *
+ * @note Tiles are cut from the vertex grid of the heightfield plane, with
+ *       'width_subdivisions - 1' & 'depth_subdivisions - 1' both multiples
+ *       of 'tile_size', and 'tile_size' a multiple of '2^lod'. Neighbouring
+ *       tiles produce identical vertices along their shared edges.
+ *
+ * @note The odd vertices of stitched edges are moved onto the edge of the
+ *       coarser neighbour, which requires 'tile_size' to be a multiple of
+ *       '2^(lod + 1)'.
+ *
+ * @note Skirt vertices follow the '(m + 1)^2' grid vertices, with 'm' being
+ *       'tile_size >> lod', as copies of the south, north, west & east edges
+ *       lowered by 'skirt_depth' along -z.
+ *
  * @note To get the required length for the returned vertex buffers,
  *       provide a pointer to 'length' alongside all vertex buffer 
  *       pointers being NULL.
  *
- * @note The output vertex buffers MUST be provided with a length of at-least
- *       the returned 'length'.
- *
- * @note If any of the output vertex buffers are provided as NULL, the
- *       associated vertex data will not be generated and returned. 
- *
  * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
 enum sg_status
-sg_indexed_sphere_vertices(
-	struct sg_indexed_sphere_info* sphere,
+sg_terrain_tile_vertices(
+	struct sg_terrain_tile_info const* tile,
 	size_t* length,
 	struct sg_position* positions,
 	struct sg_normal* normals,
@@ -282,41 +647,43 @@ sg_indexed_sphere_vertices(
 );
 
 /**
- * @brief Generate indices for a indexed & subdivided uv sphere.
+ * @brief Generate the indices shared by every tile of a heightfield.
  *
- * @param[in]     sphere  Information describing the geometry to generate.
+ * @param[in]     tile    Information describing the geometry to generate.
  * @param[in out] length  The length of required index buffer to supply.
  * @param[out]    indices Vertex indices to generate.
  *
+ * @note The indices only depend on 'tile_size', 'lod' and whether skirts
+ *       are enabled, so one index buffer serves all tiles of a lod.
+ *
+ * @note Returns SG_ERR_INVALID_RANGE when the last tile vertex does not fit
+ *       an SG_indice, for the length query as well.
+ *
  * @note To get the required length for the returned indice buffer,
  *       provide a pointer to 'length' alongside the indice buffer 
  *       pointer being NULL.
  *
- * @note The output index buffer MUST be provided with a length of at-least
- *       the returned 'length'.
- *
  * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
 enum sg_status
-sg_indexed_sphere_indices(
-    struct sg_indexed_sphere_info* info,
-    size_t* length,
-    SG_indice* indices
+sg_terrain_tile_indices(
+	struct sg_terrain_tile_info const* tile,
+	size_t* length,
+	SG_indice* indices
 );
-	
 
-struct sg_cylinder_info {
-	float height;  /// Height of the cylinder.
-	float top_radius;  /// radius of the top of the cylinder.
-	float bottom_radius;  /// Radius of the bottom of the cylinder.
-	size_t subdivisions; /// Subdivisions along the bottom of the cylinder.
+struct sg_cube_info {
+	float width;  /// width of the cube.
+	float height; /// height of the cube.
+	float depth;  /// depth of the cube.
 };
+	
 
 /**
- * @brief Generate vertices for a cylinder.
+ * @brief Generate vertices for a cube.
  *
- * @param[in]     cylinder    Information describing the geometry to generate.
+ * @param[in]     cube      Information describing the geometry to generate.
  * @param[in out] length    The length of required vertex buffers to supply.
  * @param[out]    positions Vertex positions to generate.
  * @param[out]    normals   Vertex normals to generate.
@@ -336,1507 +703,6709 @@ struct sg_cylinder_info {
  */
 SG_API_EXPORT
 enum sg_status
-sg_cylinder_vertices(
-	struct sg_cylinder_info* cylinder,
+sg_cube_vertices(
+	struct sg_cube_info* cube,
 	size_t* length,
 	struct sg_position* positions,
 	struct sg_normal* normals,
 	struct sg_texcoord* texcoords
 );
-	
-struct sg_gizmo_cone_info {
-	float height;
-	float radius;
-};
 
 /**
- * @brief Generate vertices for a gizmo cone.
+ * @brief Generate vertices for a cube into a described vertex layout.
  *
- * @param[in]     cone      Information describing the geometry to generate.
- * @param[out]    length    The length of required vertex buffers to supply.
- * @param[out]    positions Vertex positions to generate.
+ * @param[in]     cube      Information describing the geometry to generate.
+ * @param[in out] length    The length of required vertex buffer to supply.
+ * @param[in]     layout    Layout of the vertex buffer to generate into.
  *
  * @note To get the required length for the returned vertex buffer,
- *       provide a pointer to 'length' alongside all vertex buffer 
- *       pointers being NULL.
+ *       provide a pointer to 'length' alongside a NULL 'layout' or
+ *       layout buffer.
  *
- * @note The output vertex buffer MUST be provided with a length of at-least
- *       the returned 'length'.
+ * @note The layout buffer MUST be large enough to hold 'length' vertices
+ *       for every attribute with a format other than SG_VERTEX_FORMAT_NONE.
  *
  * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
 enum sg_status
-sg_gizmo_cone_vertices(
-	struct sg_gizmo_cone_info* cone,
+sg_cube_vertices_layout(
+	struct sg_cube_info* cube,
 	size_t* length,
-	struct sg_position* positions
+	struct sg_vertex_layout const* layout
 );
-	
-struct sg_gizmo_sphere_info {
-	float radius;
+
+/**
+ * @brief Allocate and generate the vertices of a cube in a single call.
+ *
+ * @param[in]  cube       Information describing the geometry to generate.
+ * @param[in]  attributes Bitmask of sg_attribute's to generate.
+ * @param[in]  allocator  Allocator used for the generated buffers.
+ * @param[out] mesh       The generated buffers and their lengths.
+ *
+ * @note The generated buffers are released with sg_mesh_free().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_cube_generate(
+	struct sg_cube_info* cube,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+);
+
+struct sg_indexed_cube_info {
+	float width;         /// width of the cube.
+	float height;        /// height of the cube.
+	float depth;         /// depth of the cube.
+	size_t subdivisions; /// quads along each edge of a face, 0 is treated as 1.
 };
 
 /**
- * @brief Generate vertices for a gizmo cone.
+ * @brief Generate vertices for a indexed & subdivided cube.
  *
- * @param[in]     cone      Information describing the geometry to generate.
- * @param[out]    length    The length of required vertex buffers to supply.
+ * @param[in]     cube      Information describing the geometry to generate.
+ * @param[in out] length    The length of required vertex buffers to supply.
  * @param[out]    positions Vertex positions to generate.
+ * @param[out]    normals   Vertex normals to generate.
+ * @param[out]    texcoords Vertex texcoords to generate.
  *
- * @note To get the required length for the returned vertex buffer,
+ * @note To get the required length for the returned vertex buffers,
  *       provide a pointer to 'length' alongside all vertex buffer 
  *       pointers being NULL.
  *
- * @note The output vertex buffer MUST be provided with a length of at-least
+ * @note The output vertex buffers MUST be provided with a length of at-least
  *       the returned 'length'.
  *
+ * @note If any of the output vertex buffers are provided as NULL, the
+ *       associated vertex data will not be generated and returned. 
+ *
+ * @note Each face is a grid of '(subdivisions + 1)^2' vertices, in the face
+ *       order, extent & texcoord orientation of sg_cube_vertices(), so a
+ *       cube with 1 subdivision has 24 vertices.
+ *
  * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
 enum sg_status
-sg_gizmo_sphere_vertices(
-	struct sg_gizmo_sphere_info* sphere,
+sg_indexed_cube_vertices(
+	struct sg_indexed_cube_info const* cube,
 	size_t* length,
-	struct sg_position* positions
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
 );
-	
-struct sg_gizmo_cube_info {
-	float width;
-	float height;
-	float depth;
-};
 
 /**
- * @brief Generate vertices for a gizmo cube.
+ * @brief Generate vertices for a indexed & subdivided cube into a described vertex layout.
  *
  * @param[in]     cube      Information describing the geometry to generate.
- * @param[out]    length    The length of required vertex buffers to supply.
- * @param[out]    positions Vertex positions to generate.
+ * @param[in out] length    The length of required vertex buffer to supply.
+ * @param[in]     layout    Layout of the vertex buffer to generate into.
  *
  * @note To get the required length for the returned vertex buffer,
- *       provide a pointer to 'length' alongside all vertex buffer 
- *       pointers being NULL.
+ *       provide a pointer to 'length' alongside a NULL 'layout' or
+ *       layout buffer.
  *
- * @note The output vertex buffer MUST be provided with a length of at-least
- *       the returned 'length'.
+ * @note The layout buffer MUST be large enough to hold 'length' vertices
+ *       for every attribute with a format other than SG_VERTEX_FORMAT_NONE.
  *
  * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
 enum sg_status
-sg_gizmo_cube_vertices(
-	struct sg_gizmo_cube_info* cube,
+sg_indexed_cube_vertices_layout(
+	struct sg_indexed_cube_info const* cube,
 	size_t* length,
-	struct sg_position* positions
+	struct sg_vertex_layout const* layout
+);
+
+/**
+ * @brief Generate indices for a indexed & subdivided cube.
+ *
+ * @param[in]     cube    Information describing the geometry to generate.
+ * @param[in out] length  The length of required index buffer to supply.
+ * @param[out]    indices Vertex indices to generate.
+ *
+ * @note To get the required length for the returned indice buffer,
+ *       provide a pointer to 'length' alongside the indice buffer 
+ *       pointer being NULL.
+ *
+ * @note The output index buffer MUST be provided with a length of at-least
+ *       the returned 'length', 36 for a cube with 1 subdivision.
+ *
+ * @note Returns SG_ERR_INVALID_RANGE when the last of the
+ *       '6 * (subdivisions + 1)^2' vertices does not fit an SG_indice, for
+ *       the length query as well.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_cube_indices(
+	struct sg_indexed_cube_info const* cube,
+	size_t* length,
+	SG_indice* indices
+);
+
+/**
+ * @brief Allocate and generate the vertices & indices of a indexed & subdivided cube in a single call.
+ *
+ * @param[in]  cube       Information describing the geometry to generate.
+ * @param[in]  attributes Bitmask of sg_attribute's to generate.
+ * @param[in]  allocator  Allocator used for the generated buffers.
+ * @param[out] mesh       The generated buffers and their lengths.
+ *
+ * @note The generated buffers are released with sg_mesh_free().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_cube_generate(
+	struct sg_indexed_cube_info const* cube,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
 );
 	
-struct sg_gizmo_capsule_info {
-	float height;
-	float diameter;
+	
+struct sg_indexed_sphere_info {
+	float radius;  /// Radius of the sphere.
+	size_t slices; /// Subdivisions along the xy axis of the sphere.
+	size_t stacks; /// Subdivisions along the z axis of the sphere.
 };
 
 /**
- * @brief Generate vertices for a gizmo cube.
+ * @brief Generate vertices for a indexed & subdivided uv sphere.
  *
- * @param[in]     cube      Information describing the geometry to generate.
- * @param[out]    length    The length of required vertex buffers to supply.
+ * @param[in]     sphere    Information describing the geometry to generate.
+ * @param[in out] length    The length of required vertex buffers to supply.
  * @param[out]    positions Vertex positions to generate.
+ * @param[out]    normals   Vertex normals to generate.
+ * @param[out]    texcoords Vertex texcoords to generate.
  *
- * @note To get the required length for the returned vertex buffer,
+ * @note To get the required length for the returned vertex buffers,
  *       provide a pointer to 'length' alongside all vertex buffer 
  *       pointers being NULL.
  *
- * @note The output vertex buffer MUST be provided with a length of at-least
+ * @note The output vertex buffers MUST be provided with a length of at-least
  *       the returned 'length'.
  *
+ * @note If any of the output vertex buffers are provided as NULL, the
+ *       associated vertex data will not be generated and returned. 
+ *
  * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
 enum sg_status
-sg_gizmo_capsule_vertices(
-	struct sg_gizmo_capsule_info* capsule,
+sg_indexed_sphere_vertices(
+	struct sg_indexed_sphere_info* sphere,
 	size_t* length,
-	struct sg_position* positions
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
 );
 
-
-
-/** @}*/
-	
-
-/** @addtogroup math
- *  @{
- */
-#ifndef	SIMPLE_GEOMETRY_DONT_INCLUDE_MATH_H
-#  include <math.h>
-#  define SG_SQUARE_ROOT(V) sqrt(V)
-#  define SG_COS(V) cos(V)
-#  define SG_SIN(V) sin(V)
-#  define SG_ATAN2(Y, X) atan2(Y, X)
-#endif
-	
-#define SG_PI 3.1415926535897932384626433832795f
-#define SG_2PI (2.0f * SG_PI)
-
-#define SG_EXPAND_XYZ(T) (T.x), (T.y), (T.z)
-
-struct sg_vec3f {
-	float x; /// x direction of a 3D vector.
-	float y; /// y direction of a 3D vector.
-	float z; /// z direction of a 3D vector.
-};
-	
 /**
- * @brief subtract two vec3's.
- * @param[in] a vector to be subtracted.
- * @param[in] b vector to use for subtraction.
- * @return a - b.
+ * @brief Generate vertices for a indexed & subdivided uv sphere into a described vertex layout.
+ *
+ * @param[in]     sphere    Information describing the geometry to generate.
+ * @param[in out] length    The length of required vertex buffer to supply.
+ * @param[in]     layout    Layout of the vertex buffer to generate into.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside a NULL 'layout' or
+ *       layout buffer.
+ *
+ * @note The layout buffer MUST be large enough to hold 'length' vertices
+ *       for every attribute with a format other than SG_VERTEX_FORMAT_NONE.
+ *
+ * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
-struct sg_vec3f
-sg_vec3f_subtract(const struct sg_vec3f a,
-				  const struct sg_vec3f b);
+enum sg_status
+sg_indexed_sphere_vertices_layout(
+	struct sg_indexed_sphere_info* sphere,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+);
 
 /**
- * @brief divide a vector3 with a divisor.
- * @param[in] a vector to be divided.
- * @param[in] f the divisor.
- * @return a / f.
+ * @brief Generate indices for a indexed & subdivided uv sphere.
+ *
+ * @param[in]     sphere  Information describing the geometry to generate.
+ * @param[in out] length  The length of required index buffer to supply.
+ * @param[out]    indices Vertex indices to generate.
+ *
+ * @note To get the required length for the returned indice buffer,
+ *       provide a pointer to 'length' alongside the indice buffer 
+ *       pointer being NULL.
+ *
+ * @note The output index buffer MUST be provided with a length of at-least
+ *       the returned 'length'.
+ *
+ * @note Returns SG_ERR_INVALID_RANGE when the last vertex of the sphere does
+ *       not fit an SG_indice, for the length query as well.
+ *
+ * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
-struct sg_vec3f
-sg_vec3f_dividef(const struct sg_vec3f a,
-				 const float f);
+enum sg_status
+sg_indexed_sphere_indices(
+    struct sg_indexed_sphere_info* info,
+    size_t* length,
+    SG_indice* indices
+);
 
 /**
- * @brief Get the cross-product of two vector3's.
- * @param[in] a vector for cross-product calculation.
- * @param[in] b vector for cross-product calculation.
- * @return a x f.
+ * @brief Allocate and generate the vertices & indices of a indexed & subdivided uv sphere in a single call.
+ *
+ * @param[in]  sphere     Information describing the geometry to generate.
+ * @param[in]  attributes Bitmask of sg_attribute's to generate.
+ * @param[in]  allocator  Allocator used for the generated buffers.
+ * @param[out] mesh       The generated buffers and their lengths.
+ *
+ * @note The generated buffers are released with sg_mesh_free().
+ *
+ * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
-struct sg_vec3f
-sg_vec3f_cross(const struct sg_vec3f a,
-			   const struct sg_vec3f b);
+enum sg_status
+sg_indexed_sphere_generate(
+	struct sg_indexed_sphere_info* sphere,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+);
 
 /**
- * @brief Get the length of a vector3.
- * @param[in] a vector to generate length from.
- * @return |a|.
+ * @brief Generate a range of vertex rows for a indexed & subdivided uv sphere.
+ *
+ * @param[in]  sphere      Information describing the geometry to generate.
+ * @param[in]  first_stack First vertex row to generate.
+ * @param[in]  last_stack  One past the last vertex row to generate, at most 'stacks + 1'.
+ * @param[out] positions   Vertex positions to generate.
+ * @param[out] normals     Vertex normals to generate.
+ * @param[out] texcoords   Vertex texcoords to generate.
+ *
+ * @note The output vertex buffers are the full buffers described by
+ *       sg_indexed_sphere_vertices(), only the vertices of the rows in
+ *       [first_stack, last_stack) are written, at their usual offsets.
+ *       Disjoint ranges can be generated concurrently.
+ *
+ * @note If any of the output vertex buffers are provided as NULL, the
+ *       associated vertex data will not be generated and returned. 
+ *
+ * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
-float
-sg_vec3f_length(const struct sg_vec3f a);
+enum sg_status
+sg_indexed_sphere_vertices_range(
+	struct sg_indexed_sphere_info* sphere,
+	const size_t first_stack,
+	const size_t last_stack,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+);
 
 /**
- * @brief Normalize a vector3.
- * @param[in] a vector to normalize.
- * @return a / |a|.
+ * @brief Generate a range of index rows for a indexed & subdivided uv sphere.
+ *
+ * @param[in]  sphere      Information describing the geometry to generate.
+ * @param[in]  first_stack First index row to generate.
+ * @param[in]  last_stack  One past the last index row to generate, at most 'stacks'.
+ * @param[out] indices     Vertex indices to generate.
+ *
+ * @note The output index buffer is the full buffer described by
+ *       sg_indexed_sphere_indices(), every row holds the 'slices * 6'
+ *       indices joining vertex rows 'i' and 'i + 1', and only the rows in
+ *       [first_stack, last_stack) are written.
+ *       Disjoint ranges can be generated concurrently.
+ *
+ * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
-struct sg_vec3f
-sg_vec3f_normalize(const struct sg_vec3f a);
+enum sg_status
+sg_indexed_sphere_indices_range(
+	struct sg_indexed_sphere_info* sphere,
+	const size_t first_stack,
+	const size_t last_stack,
+	SG_indice* indices
+);
 
+#ifdef SIMPLE_GEOMETRY_USE_PTHREADS
 /**
- * @brief convert a position vertex into a vector3.
- * @param[in] pos the position vertex to convert.
- * @return the converted vector3.
+ * @brief Generate vertices for a indexed & subdivided uv sphere using multiple threads.
+ *
+ * @param[in]     sphere       Information describing the geometry to generate.
+ * @param[in]     thread_count Amount of threads to split the rows across.
+ * @param[in out] length       The length of required vertex buffers to supply.
+ * @param[out]    positions    Vertex positions to generate.
+ * @param[out]    normals      Vertex normals to generate.
+ * @param[out]    texcoords    Vertex texcoords to generate.
+ *
+ * @note Behaves like sg_indexed_sphere_vertices(), the calling thread
+ *       generates one of the row ranges itself. Only available when
+ *       SIMPLE_GEOMETRY_USE_PTHREADS is defined.
+ *
+ * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
-struct sg_vec3f
-sg_vec3f_from_position(const struct sg_position pos);
+enum sg_status
+sg_indexed_sphere_vertices_parallel(
+	struct sg_indexed_sphere_info* sphere,
+	const size_t thread_count,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+);
 
 /**
- * @brief convert a vector3 into a normal vertex.
- * @param[in] v the vector3 to convert.
- * @return the converted normal vertex.
+ * @brief Generate indices for a indexed & subdivided uv sphere using multiple threads.
+ *
+ * @param[in]     sphere       Information describing the geometry to generate.
+ * @param[in]     thread_count Amount of threads to split the rows across.
+ * @param[in out] length       The length of required index buffer to supply.
+ * @param[out]    indices      Vertex indices to generate.
+ *
+ * @note Behaves like sg_indexed_sphere_indices(), the calling thread
+ *       generates one of the row ranges itself. Only available when
+ *       SIMPLE_GEOMETRY_USE_PTHREADS is defined.
+ *
+ * @return status code describing the result of evaluation.
  */
 SG_API_EXPORT
+enum sg_status
+sg_indexed_sphere_indices_parallel(
+	struct sg_indexed_sphere_info* sphere,
+	const size_t thread_count,
+	size_t* length,
+	SG_indice* indices
+);
+#endif
+	
+
+struct sg_cylinder_info {
+	float height;  /// Height of the cylinder.
+	float top_radius;  /// radius of the top of the cylinder.
+	float bottom_radius;  /// Radius of the bottom of the cylinder.
+	size_t subdivisions; /// Subdivisions along the bottom of the cylinder.
+	size_t stacks;       /// Subdivisions along the height of the cylinder, 0 is treated as 1.
+};
+
+/**
+ * @brief Generate vertices for a cylinder.
+ *
+ * @param[in]     cylinder    Information describing the geometry to generate.
+ * @param[in out] length    The length of required vertex buffers to supply.
+ * @param[out]    positions Vertex positions to generate.
+ * @param[out]    normals   Vertex normals to generate.
+ * @param[out]    texcoords Vertex texcoords to generate.
+ *
+ * @note To get the required length for the returned vertex buffers,
+ *       provide a pointer to 'length' alongside all vertex buffer 
+ *       pointers being NULL.
+ *
+ * @note The output vertex buffers MUST be provided with a length of at-least
+ *       the returned 'length'.
+ *
+ * @note If any of the output vertex buffers are provided as NULL, the
+ *       associated vertex data will not be generated and returned. 
+ *
+ * @note The sides get cylindrical texcoords, u going around the cylinder
+ *       and v from 0 at the top to 1 at the bottom, while the caps get
+ *       planar disc texcoords centred on (0.5, 0.5).
+ *
+ * @note Side normals are unit length and perpendicular to the slanted
+ *       side of tapered cylinders.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_cylinder_vertices(
+	struct sg_cylinder_info* cylinder,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+);
+
+/**
+ * @brief Generate vertices for a cylinder into a described vertex layout.
+ *
+ * @param[in]     cylinder  Information describing the geometry to generate.
+ * @param[in out] length    The length of required vertex buffer to supply.
+ * @param[in]     layout    Layout of the vertex buffer to generate into.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside a NULL 'layout' or
+ *       layout buffer.
+ *
+ * @note The layout buffer MUST be large enough to hold 'length' vertices
+ *       for every attribute with a format other than SG_VERTEX_FORMAT_NONE.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_cylinder_vertices_layout(
+	struct sg_cylinder_info* cylinder,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+);
+
+/**
+ * @brief Allocate and generate the vertices of a cylinder in a single call.
+ *
+ * @param[in]  cylinder   Information describing the geometry to generate.
+ * @param[in]  attributes Bitmask of sg_attribute's to generate.
+ * @param[in]  allocator  Allocator used for the generated buffers.
+ * @param[out] mesh       The generated buffers and their lengths.
+ *
+ * @note The generated buffers are released with sg_mesh_free().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_cylinder_generate(
+	struct sg_cylinder_info* cylinder,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+);
+
+/**
+ * @brief Generate vertices for a indexed cylinder.
+ *
+ * @param[in]     cylinder  Information describing the geometry to generate.
+ * @param[in out] length    The length of required vertex buffers to supply.
+ * @param[out]    positions Vertex positions to generate.
+ * @param[out]    normals   Vertex normals to generate.
+ * @param[out]    texcoords Vertex texcoords to generate.
+ *
+ * @note To get the required length for the returned vertex buffers,
+ *       provide a pointer to 'length' alongside all vertex buffer 
+ *       pointers being NULL.
+ *
+ * @note The output vertex buffers MUST be provided with a length of at-least
+ *       the returned 'length'.
+ *
+ * @note If any of the output vertex buffers are provided as NULL, the
+ *       associated vertex data will not be generated and returned. 
+ *
+ * @note The side comes first, as 'stacks + 1' rings of 'subdivisions + 1'
+ *       vertices from the bottom up, the last vertex of a ring being a seam copy of the
+ *       first with a texcoord u of 1. The bottom & top caps follow, each as
+ *       a centre vertex and a ring of 'subdivisions' vertices with planar
+ *       disc texcoords. A 'top_radius' of 0 gives a cone. 'subdivisions'
+ *       must be at-least 2.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_cylinder_vertices(
+	struct sg_cylinder_info const* cylinder,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+);
+
+/**
+ * @brief Generate vertices for a indexed cylinder into a described vertex layout.
+ *
+ * @param[in]     cylinder  Information describing the geometry to generate.
+ * @param[in out] length    The length of required vertex buffer to supply.
+ * @param[in]     layout    Layout of the vertex buffer to generate into.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside a NULL 'layout' or
+ *       layout buffer.
+ *
+ * @note The layout buffer MUST be large enough to hold 'length' vertices
+ *       for every attribute with a format other than SG_VERTEX_FORMAT_NONE.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_cylinder_vertices_layout(
+	struct sg_cylinder_info const* cylinder,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+);
+
+/**
+ * @brief Generate indices for a indexed cylinder.
+ *
+ * @param[in]     cylinder Information describing the geometry to generate.
+ * @param[in out] length   The length of required index buffer to supply.
+ * @param[out]    indices  Vertex indices to generate.
+ *
+ * @note To get the required length for the returned indice buffer,
+ *       provide a pointer to 'length' alongside the indice buffer 
+ *       pointer being NULL.
+ *
+ * @note The output index buffer MUST be provided with a length of at-least
+ *       the returned 'length'.
+ *
+ * @note Returns SG_ERR_INVALID_RANGE when the last of the
+ *       '(stacks + 3) * (subdivisions + 1)' vertices does not fit an
+ *       SG_indice, for the length query as well.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_cylinder_indices(
+	struct sg_cylinder_info const* cylinder,
+	size_t* length,
+	SG_indice* indices
+);
+
+/**
+ * @brief Allocate and generate the vertices & indices of a indexed cylinder in a single call.
+ *
+ * @param[in]  cylinder   Information describing the geometry to generate.
+ * @param[in]  attributes Bitmask of sg_attribute's to generate.
+ * @param[in]  allocator  Allocator used for the generated buffers.
+ * @param[out] mesh       The generated buffers and their lengths.
+ *
+ * @note The generated buffers are released with sg_mesh_free().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_indexed_cylinder_generate(
+	struct sg_cylinder_info const* cylinder,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+);
+	
+#ifndef SG_GIZMO_STRIP_RESTART
+#  define SG_GIZMO_STRIP_RESTART ((SG_indice)~(SG_indice)0)
+#endif
+
+enum sg_gizmo_topology {
+	SG_GIZMO_TOPOLOGY_TRIANGLES,         /// every line as a degenerate triangle (a, b, a).
+	SG_GIZMO_TOPOLOGY_LINE_LIST,         /// every line as 2 vertices.
+	SG_GIZMO_TOPOLOGY_INDEXED_LINE_LIST, /// shared vertices, every line as 2 indices.
+	SG_GIZMO_TOPOLOGY_LINE_STRIP,        /// shared vertices, strips of indices ended by SG_GIZMO_STRIP_RESTART.
+};
+
+struct sg_gizmo_cone_info {
+	float height;
+	float radius;
+	enum sg_gizmo_topology topology; /// primitive topology to generate.
+	size_t subdivisions;             /// subdivisions of the gizmo circles, 0 for SG_GIZMO_CIRCLE_SUBDIVISIONS.
+};
+
+/**
+ * @brief Generate vertices for a gizmo cone.
+ *
+ * @param[in]     cone      Information describing the geometry to generate.
+ * @param[out]    length    The length of required vertex buffers to supply.
+ * @param[out]    positions Vertex positions to generate.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside all vertex buffer 
+ *       pointers being NULL.
+ *
+ * @note The output vertex buffer MUST be provided with a length of at-least
+ *       the returned 'length'.
+ *
+ * @note The vertices follow the 'topology' of the gizmo, the indexed
+ *       topologies take their indices from sg_gizmo_cone_indices().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_cone_vertices(
+	struct sg_gizmo_cone_info* cone,
+	size_t* length,
+	struct sg_position* positions
+);
+
+/**
+ * @brief Generate indices for a gizmo cone.
+ *
+ * @param[in]     cone    Information describing the geometry to generate.
+ * @param[in out] length  The length of required index buffer to supply.
+ * @param[out]    indices Vertex indices to generate.
+ *
+ * @note To get the required length for the returned indice buffer,
+ *       provide a pointer to 'length' alongside the indice buffer 
+ *       pointer being NULL.
+ *
+ * @note The length is 0 for the non-indexed topologies.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_cone_indices(
+	struct sg_gizmo_cone_info* cone,
+	size_t* length,
+	SG_indice* indices
+);
+	
+struct sg_gizmo_sphere_info {
+	float radius;
+	enum sg_gizmo_topology topology; /// primitive topology to generate.
+	size_t subdivisions;             /// subdivisions of the gizmo circles, 0 for SG_GIZMO_CIRCLE_SUBDIVISIONS.
+};
+
+/**
+ * @brief Generate vertices for a gizmo sphere.
+ *
+ * @param[in]     sphere    Information describing the geometry to generate.
+ * @param[out]    length    The length of required vertex buffers to supply.
+ * @param[out]    positions Vertex positions to generate.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside all vertex buffer 
+ *       pointers being NULL.
+ *
+ * @note The output vertex buffer MUST be provided with a length of at-least
+ *       the returned 'length'.
+ *
+ * @note The vertices follow the 'topology' of the gizmo, the indexed
+ *       topologies take their indices from sg_gizmo_sphere_indices().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_sphere_vertices(
+	struct sg_gizmo_sphere_info* sphere,
+	size_t* length,
+	struct sg_position* positions
+);
+
+/**
+ * @brief Generate indices for a gizmo sphere.
+ *
+ * @param[in]     sphere  Information describing the geometry to generate.
+ * @param[in out] length  The length of required index buffer to supply.
+ * @param[out]    indices Vertex indices to generate.
+ *
+ * @note To get the required length for the returned indice buffer,
+ *       provide a pointer to 'length' alongside the indice buffer 
+ *       pointer being NULL.
+ *
+ * @note The length is 0 for the non-indexed topologies.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_sphere_indices(
+	struct sg_gizmo_sphere_info* sphere,
+	size_t* length,
+	SG_indice* indices
+);
+	
+struct sg_gizmo_cube_info {
+	float width;
+	float height;
+	float depth;
+	enum sg_gizmo_topology topology; /// primitive topology to generate.
+};
+
+/**
+ * @brief Generate vertices for a gizmo cube.
+ *
+ * @param[in]     cube      Information describing the geometry to generate.
+ * @param[out]    length    The length of required vertex buffers to supply.
+ * @param[out]    positions Vertex positions to generate.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside all vertex buffer 
+ *       pointers being NULL.
+ *
+ * @note The output vertex buffer MUST be provided with a length of at-least
+ *       the returned 'length'.
+ *
+ * @note The vertices follow the 'topology' of the gizmo, the indexed
+ *       topologies take their indices from sg_gizmo_cube_indices().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_cube_vertices(
+	struct sg_gizmo_cube_info* cube,
+	size_t* length,
+	struct sg_position* positions
+);
+
+/**
+ * @brief Generate indices for a gizmo cube.
+ *
+ * @param[in]     cube    Information describing the geometry to generate.
+ * @param[in out] length  The length of required index buffer to supply.
+ * @param[out]    indices Vertex indices to generate.
+ *
+ * @note To get the required length for the returned indice buffer,
+ *       provide a pointer to 'length' alongside the indice buffer 
+ *       pointer being NULL.
+ *
+ * @note The length is 0 for the non-indexed topologies.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_cube_indices(
+	struct sg_gizmo_cube_info* cube,
+	size_t* length,
+	SG_indice* indices
+);
+	
+struct sg_gizmo_capsule_info {
+	float height;
+	float diameter;
+	enum sg_gizmo_topology topology; /// primitive topology to generate.
+	size_t subdivisions;             /// subdivisions of the gizmo circles, rounded up to a multiple of 4, 0 for SG_GIZMO_CIRCLE_SUBDIVISIONS.
+};
+
+/**
+ * @brief Generate vertices for a gizmo capsule.
+ *
+ * @param[in]     capsule   Information describing the geometry to generate.
+ * @param[out]    length    The length of required vertex buffers to supply.
+ * @param[out]    positions Vertex positions to generate.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside all vertex buffer 
+ *       pointers being NULL.
+ *
+ * @note The output vertex buffer MUST be provided with a length of at-least
+ *       the returned 'length'.
+ *
+ * @note The vertices follow the 'topology' of the gizmo, the indexed
+ *       topologies take their indices from sg_gizmo_capsule_indices().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_capsule_vertices(
+	struct sg_gizmo_capsule_info* capsule,
+	size_t* length,
+	struct sg_position* positions
+);
+
+/**
+ * @brief Generate indices for a gizmo capsule.
+ *
+ * @param[in]     capsule Information describing the geometry to generate.
+ * @param[in out] length  The length of required index buffer to supply.
+ * @param[out]    indices Vertex indices to generate.
+ *
+ * @note To get the required length for the returned indice buffer,
+ *       provide a pointer to 'length' alongside the indice buffer 
+ *       pointer being NULL.
+ *
+ * @note The length is 0 for the non-indexed topologies.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_capsule_indices(
+	struct sg_gizmo_capsule_info* capsule,
+	size_t* length,
+	SG_indice* indices
+);
+
+/**
+ * @brief Pick the subdivisions of a gizmo circle from its radius on screen.
+ *
+ * @param[in] screen_radius Projected radius of the circle, in pixels.
+ * @param[in] max_error     Largest distance allowed between the circle and its segments, in pixels.
+ *
+ * @note The projected radius of a circle of radius 'r' at distance 'd' is
+ *       about 'r * viewport_height / (2 * d * tan(fov_y / 2))'.
+ *
+ * @return subdivisions between 4 and SG_GIZMO_CIRCLE_SUBDIVISIONS, as a multiple of 4.
+ */
+SG_API_EXPORT
+size_t
+sg_gizmo_circle_subdivisions(
+	const float screen_radius,
+	const float max_error
+);
+
+
+
+/** @}*/
+	
+
+/** @addtogroup mesh-batching
+ *  @{
+ */
+
+struct sg_submesh {
+	size_t vertices_offset; /// first vertex of the submesh in the batch.
+	size_t vertices_length; /// amount of vertices in the submesh.
+	size_t indices_offset;  /// first index of the submesh in the batch.
+	size_t indices_length;  /// amount of indices, 0 for non-indexed submeshes.
+};
+
+/**
+ * A batch of primitives sharing one set of growing vertex & index streams.
+ * Indices of indexed primitives are rebased onto the shared vertex streams,
+ * and every added primitive is described by a submesh record.
+ */
+struct sg_mesh_batch {
+	struct sg_allocator allocator; /// allocator used for the batch streams.
+	unsigned int attributes;       /// bitmask of sg_attribute's to generate.
+	struct sg_mesh mesh;           /// shared streams of the whole batch.
+	size_t vertices_capacity;      /// allocated length of the vertex streams.
+	size_t indices_capacity;       /// allocated length of the index stream.
+	struct sg_submesh* submeshes;  /// records of the added primitives.
+	size_t submeshes_length;       /// amount of added primitives.
+	size_t submeshes_capacity;     /// allocated length of the submesh records.
+};
+
+/**
+ * @brief Initialize an empty mesh batch.
+ *
+ * @param[out] batch      The batch to initialize.
+ * @param[in]  attributes Bitmask of sg_attribute's to generate.
+ * @param[in]  allocator  Allocator used for the batch streams.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_mesh_batch_init(
+	struct sg_mesh_batch* batch,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator
+);
+
+/**
+ * @brief Make room for at-least the given amount of additional data.
+ *
+ * @param[in out] batch     The batch to grow.
+ * @param[in]     vertices  Amount of additional vertices.
+ * @param[in]     indices   Amount of additional indices.
+ * @param[in]     submeshes Amount of additional primitives.
+ *
+ * @note Reserving up front turns a whole scene into a handful of allocations.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_mesh_batch_reserve(
+	struct sg_mesh_batch* batch,
+	const size_t vertices,
+	const size_t indices,
+	const size_t submeshes
+);
+
+/**
+ * @brief Remove all primitives from the batch, keeping its memory.
+ *
+ * @param[in out] batch The batch to clear.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_mesh_batch_clear(struct sg_mesh_batch* batch);
+
+/**
+ * @brief Release the memory of a batch.
+ *
+ * @param[in out] batch The batch to release, it is reset to be empty.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_mesh_batch_free(struct sg_mesh_batch* batch);
+
+/**
+ * @brief Append a indexed & subdivided plane to a batch.
+ *
+ * @param[in out] batch   The batch to append to.
+ * @param[in]     plane   Information describing the geometry to generate.
+ * @param[out]    submesh Index of the appended submesh record, can be NULL.
+ *
+ * @note Fails with SG_ERR_INVALID_RANGE, leaving the batch untouched, when
+ *       the vertices of the batch would no longer fit in SG_indice.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_mesh_batch_add_indexed_plane(
+	struct sg_mesh_batch* batch,
+	struct sg_indexed_plane_info const* plane,
+	size_t* submesh
+);
+
+/**
+ * @brief Append a cube to a batch.
+ *
+ * @param[in out] batch   The batch to append to.
+ * @param[in]     cube    Information describing the geometry to generate.
+ * @param[out]    submesh Index of the appended submesh record, can be NULL.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_mesh_batch_add_cube(
+	struct sg_mesh_batch* batch,
+	struct sg_cube_info* cube,
+	size_t* submesh
+);
+
+/**
+ * @brief Append a indexed & subdivided uv sphere to a batch.
+ *
+ * @param[in out] batch   The batch to append to.
+ * @param[in]     sphere  Information describing the geometry to generate.
+ * @param[out]    submesh Index of the appended submesh record, can be NULL.
+ *
+ * @note Fails with SG_ERR_INVALID_RANGE, leaving the batch untouched, when
+ *       the vertices of the batch would no longer fit in SG_indice.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_mesh_batch_add_indexed_sphere(
+	struct sg_mesh_batch* batch,
+	struct sg_indexed_sphere_info* sphere,
+	size_t* submesh
+);
+
+/**
+ * @brief Append a cylinder to a batch.
+ *
+ * @param[in out] batch    The batch to append to.
+ * @param[in]     cylinder Information describing the geometry to generate.
+ * @param[out]    submesh  Index of the appended submesh record, can be NULL.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_mesh_batch_add_cylinder(
+	struct sg_mesh_batch* batch,
+	struct sg_cylinder_info* cylinder,
+	size_t* submesh
+);
+
+/** @}*/
+	
+
+/** @addtogroup math
+ *  @{
+ */
+#ifndef	SIMPLE_GEOMETRY_DONT_INCLUDE_MATH_H
+#  include <math.h>
+#  define SG_SQUARE_ROOT(V) sqrt(V)
+#  define SG_COS(V) cos(V)
+#  define SG_SIN(V) sin(V)
+#  define SG_ATAN2(Y, X) atan2(Y, X)
+#  define SG_ACOS(V) acos(V)
+#endif
+	
+#define SG_PI 3.1415926535897932384626433832795f
+#define SG_2PI (2.0f * SG_PI)
+
+#define SG_EXPAND_XYZ(T) (T.x), (T.y), (T.z)
+
+struct sg_vec3f {
+	float x; /// x direction of a 3D vector.
+	float y; /// y direction of a 3D vector.
+	float z; /// z direction of a 3D vector.
+};
+	
+/**
+ * @brief subtract two vec3's.
+ * @param[in] a vector to be subtracted.
+ * @param[in] b vector to use for subtraction.
+ * @return a - b.
+ */
+SG_API_EXPORT
+struct sg_vec3f
+sg_vec3f_subtract(const struct sg_vec3f a,
+				  const struct sg_vec3f b);
+
+/**
+ * @brief divide a vector3 with a divisor.
+ * @param[in] a vector to be divided.
+ * @param[in] f the divisor.
+ * @return a / f.
+ */
+SG_API_EXPORT
+struct sg_vec3f
+sg_vec3f_dividef(const struct sg_vec3f a,
+				 const float f);
+
+/**
+ * @brief Get the cross-product of two vector3's.
+ * @param[in] a vector for cross-product calculation.
+ * @param[in] b vector for cross-product calculation.
+ * @return a x f.
+ */
+SG_API_EXPORT
+struct sg_vec3f
+sg_vec3f_cross(const struct sg_vec3f a,
+			   const struct sg_vec3f b);
+
+/**
+ * @brief Get the length of a vector3.
+ * @param[in] a vector to generate length from.
+ * @return |a|.
+ */
+SG_API_EXPORT
+float
+sg_vec3f_length(const struct sg_vec3f a);
+
+/**
+ * @brief Normalize a vector3.
+ * @param[in] a vector to normalize.
+ * @return a / |a|.
+ */
+SG_API_EXPORT
+struct sg_vec3f
+sg_vec3f_normalize(const struct sg_vec3f a);
+
+/**
+ * @brief convert a position vertex into a vector3.
+ * @param[in] pos the position vertex to convert.
+ * @return the converted vector3.
+ */
+SG_API_EXPORT
+struct sg_vec3f
+sg_vec3f_from_position(const struct sg_position pos);
+
+/**
+ * @brief convert a vector3 into a normal vertex.
+ * @param[in] v the vector3 to convert.
+ * @return the converted normal vertex.
+ */
+SG_API_EXPORT
+struct sg_normal
+sg_normal_from_vec3f(const struct sg_vec3f v);
+
+/**
+ * Affine transform of 3 rows, the linear part in the first three columns and
+ * the translation in the last one: p' = m * (p, 1).
+ */
+struct sg_mat3x4 {
+	float m[3][4]; /// rows of the transform.
+};
+
+/**
+ * @brief Get the identity transform.
+ * @return the identity transform.
+ */
+SG_API_EXPORT
+struct sg_mat3x4
+sg_mat3x4_identity();
+
+/**
+ * @brief Transform a point with an affine transform.
+ * @param[in] m the transform.
+ * @param[in] p the point to transform.
+ * @return m * (p, 1).
+ */
+SG_API_EXPORT
+struct sg_vec3f
+sg_mat3x4_transform_point(const struct sg_mat3x4 m,
+						  const struct sg_vec3f p);
+
+struct sg_quatf {
+	float x; /// x of the vector part of a quaternion.
+	float y; /// y of the vector part of a quaternion.
+	float z; /// z of the vector part of a quaternion.
+	float w; /// scalar part of a quaternion.
+};
+
+/**
+ * @brief Build the transform scaling, then rotating, then translating.
+ * @param[in] translation translation of the transform.
+ * @param[in] rotation    unit quaternion of the rotation of the transform.
+ * @param[in] scale       scale along each axis of the transform.
+ * @return the transform.
+ */
+SG_API_EXPORT
+struct sg_mat3x4
+sg_mat3x4_from_trs(const struct sg_vec3f translation,
+				   const struct sg_quatf rotation,
+				   const struct sg_vec3f scale);
+	
+/** @}*/
+
+
+/** @addtogroup materials
+ *  @{
+ */
+
+struct sg_material {
+	struct sg_vec3f ambient;  /// ambient color for material.
+	struct sg_vec3f diffuse;  /// diffuse color for material.
+	struct sg_vec3f specular; /// specular color for material.
+	float shininess;          /// shininess color for material.
+};
+
+/**
+ * @brief get the material properties of gold. * @return the material.
+ */
+SG_API_EXPORT
+struct sg_material
+sg_material_gold(); 
+
+/**
+ * @brief get the material properties of obsidian.
+ * @return the material.
+ */
+SG_API_EXPORT
+struct sg_material
+sg_material_obsidian(); 
+	
+/**
+ * @brief get the material properties of ruby.
+ * @return the material.
+ */
+SG_API_EXPORT
+struct sg_material
+sg_material_ruby(); 
+
+/**
+ * @brief get the material properties of emerald.
+ * @return the material.
+ */
+SG_API_EXPORT
+struct sg_material
+sg_material_emerald(); 
+
+/**
+ * @brief get the material properties of a standard flat white.
+ * @return the material.
+ */
+SG_API_EXPORT
+struct sg_material
+sg_material_default_flat_white();
+	
+/** @}*/
+
+
+/** @addtogroup gizmo-cache
+ *  @{
+ */
+
+enum sg_gizmo_shape {
+	SG_GIZMO_SHAPE_CONE,    /// cone of height 1 & radius 1.
+	SG_GIZMO_SHAPE_SPHERE,  /// sphere of radius 1.
+	SG_GIZMO_SHAPE_CUBE,    /// cube of width, height & depth 1.
+	SG_GIZMO_SHAPE_CAPSULE, /// capsule of radius 1, with the centres of its caps at y = -1 & y = 1.
+	SG_GIZMO_SHAPE_COUNT,
+};
+
+/**
+ * Unit gizmos generated once, to be instanced many times over. The template
+ * of each shape is a position only mesh, indexed for the indexed topologies.
+ */
+struct sg_gizmo_cache {
+	struct sg_allocator allocator;                 /// allocator of the templates.
+	enum sg_gizmo_topology topology;               /// topology of the templates.
+	size_t subdivisions;                           /// subdivisions of the template circles, 0 for SG_GIZMO_CIRCLE_SUBDIVISIONS.
+	struct sg_mesh templates[SG_GIZMO_SHAPE_COUNT]; /// unit gizmo of each shape.
+};
+
+/**
+ * Placement of a unit gizmo, usable as is as a record of an instance stream.
+ * A vertex p of the unit gizmo lands at 'center + scale * p', moved by
+ * 'stretch' along y away from the centre of capsules.
+ */
+struct sg_gizmo_instance {
+	struct sg_vec3f center; /// translation of the instance.
+	struct sg_vec3f scale;  /// scale of the unit gizmo.
+	float stretch;          /// distance the halves of a capsule move apart along y, 0 for other shapes.
+	uint32_t color;         /// color of the instance, carried along for instance streams.
+};
+
+/**
+ * @brief Generate the unit gizmo of every shape.
+ *
+ * @param[out] cache        The cache to initialize.
+ * @param[in]  topology     Primitive topology of the templates.
+ * @param[in]  subdivisions Subdivisions of the template circles, 0 for SG_GIZMO_CIRCLE_SUBDIVISIONS.
+ * @param[in]  allocator    Allocator used for the templates.
+ *
+ * @note The templates are released with sg_gizmo_cache_free().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_cache_init(
+	struct sg_gizmo_cache* cache,
+	const enum sg_gizmo_topology topology,
+	const size_t subdivisions,
+	struct sg_allocator const* allocator
+);
+
+/**
+ * @brief Release the templates of a gizmo cache.
+ *
+ * @param[in out] cache The cache to release.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_cache_free(struct sg_gizmo_cache* cache);
+
+/**
+ * @brief Get the instance placing a unit cone as a gizmo cone.
+ * @param[in] cone   Information describing the gizmo.
+ * @param[in] center Translation of the gizmo.
+ * @param[in] color  Color of the instance.
+ * @return the instance.
+ */
+SG_API_EXPORT
+struct sg_gizmo_instance
+sg_gizmo_cone_instance(
+	struct sg_gizmo_cone_info const* cone,
+	const struct sg_vec3f center,
+	const uint32_t color
+);
+
+/**
+ * @brief Get the instance placing a unit sphere as a gizmo sphere.
+ * @param[in] sphere Information describing the gizmo.
+ * @param[in] center Translation of the gizmo.
+ * @param[in] color  Color of the instance.
+ * @return the instance.
+ */
+SG_API_EXPORT
+struct sg_gizmo_instance
+sg_gizmo_sphere_instance(
+	struct sg_gizmo_sphere_info const* sphere,
+	const struct sg_vec3f center,
+	const uint32_t color
+);
+
+/**
+ * @brief Get the instance placing a unit cube as a gizmo cube.
+ * @param[in] cube   Information describing the gizmo.
+ * @param[in] center Translation of the gizmo.
+ * @param[in] color  Color of the instance.
+ * @return the instance.
+ */
+SG_API_EXPORT
+struct sg_gizmo_instance
+sg_gizmo_cube_instance(
+	struct sg_gizmo_cube_info const* cube,
+	const struct sg_vec3f center,
+	const uint32_t color
+);
+
+/**
+ * @brief Get the instance placing a unit capsule as a gizmo capsule.
+ * @param[in] capsule Information describing the gizmo.
+ * @param[in] center  Translation of the gizmo.
+ * @param[in] color   Color of the instance.
+ * @return the instance.
+ */
+SG_API_EXPORT
+struct sg_gizmo_instance
+sg_gizmo_capsule_instance(
+	struct sg_gizmo_capsule_info const* capsule,
+	const struct sg_vec3f center,
+	const uint32_t color
+);
+
+/**
+ * @brief Bake instances of a cached unit gizmo into one vertex buffer.
+ *
+ * @param[in]     cache            The cache holding the unit gizmo.
+ * @param[in]     shape            Shape of the instances.
+ * @param[in]     instances        Instances to bake.
+ * @param[in]     instances_length Length of 'instances'.
+ * @param[in out] length           The length of required vertex buffer to supply.
+ * @param[out]    positions        Vertex positions to generate.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside a NULL 'positions'.
+ *
+ * @note The instances follow each other, each with the vertices of the
+ *       template of 'shape'.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_cache_bake(
+	struct sg_gizmo_cache const* cache,
+	const enum sg_gizmo_shape shape,
+	struct sg_gizmo_instance const* instances,
+	const size_t instances_length,
+	size_t* length,
+	struct sg_position* positions
+);
+
+/**
+ * @brief Generate the indices of instances baked with sg_gizmo_cache_bake().
+ *
+ * @param[in]     cache            The cache holding the unit gizmo.
+ * @param[in]     shape            Shape of the instances.
+ * @param[in]     instances_length Amount of baked instances.
+ * @param[in out] length           The length of required index buffer to supply.
+ * @param[out]    indices          Vertex indices to generate.
+ *
+ * @note To get the required length for the returned indice buffer,
+ *       provide a pointer to 'length' alongside the indice buffer 
+ *       pointer being NULL. The length is 0 for the non-indexed topologies.
+ *
+ * @note Returns SG_ERR_INVALID_RANGE when the baked vertices would need
+ *       indices beyond SG_GIZMO_STRIP_RESTART, that is when
+ *       'instances_length' times the template vertex count exceeds it.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_cache_bake_indices(
+	struct sg_gizmo_cache const* cache,
+	const enum sg_gizmo_shape shape,
+	const size_t instances_length,
+	size_t* length,
+	SG_indice* indices
+);
+
+/**
+ * @brief Bake instances of a cached unit gizmo, each through its own transform.
+ *
+ * @param[in]     cache            The cache holding the unit gizmo.
+ * @param[in]     shape            Shape of the instances.
+ * @param[in]     instances        Instances to bake.
+ * @param[in]     transforms       Transform of each instance, applied after the instance.
+ * @param[in]     instances_length Length of 'instances' & 'transforms'.
+ * @param[in out] length           The length of required vertex buffer to supply.
+ * @param[out]    positions        Vertex positions to generate.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside a NULL 'positions'.
+ *
+ * @note The indices are those of sg_gizmo_cache_bake_indices().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_cache_bake_transformed(
+	struct sg_gizmo_cache const* cache,
+	const enum sg_gizmo_shape shape,
+	struct sg_gizmo_instance const* instances,
+	struct sg_mat3x4 const* transforms,
+	const size_t instances_length,
+	size_t* length,
+	struct sg_position* positions
+);
+
+/** @}*/
+
+
+/** @addtogroup gizmo-transform
+ *  @{
+ */
+
+/**
+ * @brief Generate vertices for a gizmo cone placed by an affine transform.
+ *
+ * @param[in]     cone      Information describing the geometry to generate.
+ * @param[in]     transform Transform of the gizmo, NULL for none.
+ * @param[in out] length    The length of required vertex buffer to supply.
+ * @param[out]    positions Vertex positions to generate.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside a NULL 'positions'.
+ *
+ * @note The indexed topologies take their indices from sg_gizmo_cone_indices().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_cone_vertices_transformed(
+	struct sg_gizmo_cone_info* cone,
+	struct sg_mat3x4 const* transform,
+	size_t* length,
+	struct sg_position* positions
+);
+
+/**
+ * @brief Generate vertices for a gizmo sphere placed by an affine transform.
+ *
+ * @param[in]     sphere    Information describing the geometry to generate.
+ * @param[in]     transform Transform of the gizmo, NULL for none.
+ * @param[in out] length    The length of required vertex buffer to supply.
+ * @param[out]    positions Vertex positions to generate.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside a NULL 'positions'.
+ *
+ * @note The indexed topologies take their indices from sg_gizmo_sphere_indices().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_sphere_vertices_transformed(
+	struct sg_gizmo_sphere_info* sphere,
+	struct sg_mat3x4 const* transform,
+	size_t* length,
+	struct sg_position* positions
+);
+
+/**
+ * @brief Generate vertices for a gizmo cube placed by an affine transform.
+ *
+ * @param[in]     cube      Information describing the geometry to generate.
+ * @param[in]     transform Transform of the gizmo, NULL for none.
+ * @param[in out] length    The length of required vertex buffer to supply.
+ * @param[out]    positions Vertex positions to generate.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside a NULL 'positions'.
+ *
+ * @note The indexed topologies take their indices from sg_gizmo_cube_indices().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_cube_vertices_transformed(
+	struct sg_gizmo_cube_info* cube,
+	struct sg_mat3x4 const* transform,
+	size_t* length,
+	struct sg_position* positions
+);
+
+/**
+ * @brief Generate vertices for a gizmo capsule placed by an affine transform.
+ *
+ * @param[in]     capsule   Information describing the geometry to generate.
+ * @param[in]     transform Transform of the gizmo, NULL for none.
+ * @param[in out] length    The length of required vertex buffer to supply.
+ * @param[out]    positions Vertex positions to generate.
+ *
+ * @note To get the required length for the returned vertex buffer,
+ *       provide a pointer to 'length' alongside a NULL 'positions'.
+ *
+ * @note The indexed topologies take their indices from sg_gizmo_capsule_indices().
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_gizmo_capsule_vertices_transformed(
+	struct sg_gizmo_capsule_info* capsule,
+	struct sg_mat3x4 const* transform,
+	size_t* length,
+	struct sg_position* positions
+);
+
+/** @}*/
+
+
+/** @addtogroup debug-draw
+ *  @{
+ */
+
+enum sg_debug_draw_overflow {
+	SG_DEBUG_DRAW_OVERFLOW_DROP,  /// skip the requests that do not fit whole, counting them in 'dropped'.
+	SG_DEBUG_DRAW_OVERFLOW_ERROR, /// reject the requests that do not fit whole with SG_ERR_BUFFER_FULL.
+};
+
+/**
+ * Line list of one frame, 2 vertices per segment.
+ */
+struct sg_debug_draw_buffer {
+	struct sg_position* positions; /// vertex positions of the frame.
+	uint32_t* colors;              /// color of each vertex.
+	size_t length;                 /// vertices written.
+	size_t dropped;                /// requests dropped for lack of room.
+};
+
+/**
+ * Immediate mode accumulator of debug lines & gizmos. Requests are appended
+ * to the back buffer, sg_debug_draw_swap() hands it out as the frame to draw
+ * and resets the other one for the next frame. All the memory is allocated
+ * by sg_debug_draw_init().
+ */
+struct sg_debug_draw {
+	struct sg_gizmo_cache cache;            /// unit line list gizmos placed by the requests.
+	enum sg_debug_draw_overflow overflow;   /// what happens to requests that do not fit.
+	size_t capacity;                        /// vertices of each buffer.
+	struct sg_debug_draw_buffer buffers[2]; /// buffers of the frame being built & of the previous frame.
+	size_t back;                            /// index of the buffer of the frame being built.
+};
+
+/**
+ * @brief Allocate the buffers & gizmos of a debug draw accumulator.
+ *
+ * @param[out] draw         The accumulator to initialize.
+ * @param[in]  capacity     Vertices of each of the two buffers.
+ * @param[in]  subdivisions Subdivisions of the gizmo circles, 0 for SG_GIZMO_CIRCLE_SUBDIVISIONS.
+ * @param[in]  overflow     What happens to requests that do not fit.
+ * @param[in]  allocator    Allocator used for the buffers & gizmos.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_debug_draw_init(
+	struct sg_debug_draw* draw,
+	const size_t capacity,
+	const size_t subdivisions,
+	const enum sg_debug_draw_overflow overflow,
+	struct sg_allocator const* allocator
+);
+
+/**
+ * @brief Release the buffers & gizmos of a debug draw accumulator.
+ *
+ * @param[in out] draw The accumulator to release.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_debug_draw_free(struct sg_debug_draw* draw);
+
+/**
+ * @brief Finish the frame being built and start the next one.
+ *
+ * @param[in out] draw  The accumulator.
+ * @param[out]    frame The lines of the finished frame, valid until the next swap.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_debug_draw_swap(
+	struct sg_debug_draw* draw,
+	struct sg_debug_draw_buffer* frame
+);
+
+/**
+ * @brief Draw a line segment.
+ *
+ * @param[in out] draw  The accumulator.
+ * @param[in]     a     First end of the segment.
+ * @param[in]     b     Second end of the segment.
+ * @param[in]     color Color of the segment.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_debug_draw_line(
+	struct sg_debug_draw* draw,
+	const struct sg_vec3f a,
+	const struct sg_vec3f b,
+	const uint32_t color
+);
+
+/**
+ * @brief Draw a gizmo cone.
+ *
+ * @param[in out] draw      The accumulator.
+ * @param[in]     cone      Information describing the gizmo.
+ * @param[in]     transform Transform of the gizmo, NULL for none.
+ * @param[in]     color     Color of the gizmo.
+ *
+ * @note The topology & subdivisions of 'cone' are those of the accumulator.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_debug_draw_cone(
+	struct sg_debug_draw* draw,
+	struct sg_gizmo_cone_info const* cone,
+	struct sg_mat3x4 const* transform,
+	const uint32_t color
+);
+
+/**
+ * @brief Draw a gizmo sphere.
+ *
+ * @param[in out] draw      The accumulator.
+ * @param[in]     sphere    Information describing the gizmo.
+ * @param[in]     transform Transform of the gizmo, NULL for none.
+ * @param[in]     color     Color of the gizmo.
+ *
+ * @note The topology & subdivisions of 'sphere' are those of the accumulator.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_debug_draw_sphere(
+	struct sg_debug_draw* draw,
+	struct sg_gizmo_sphere_info const* sphere,
+	struct sg_mat3x4 const* transform,
+	const uint32_t color
+);
+
+/**
+ * @brief Draw a gizmo cube.
+ *
+ * @param[in out] draw      The accumulator.
+ * @param[in]     cube      Information describing the gizmo.
+ * @param[in]     transform Transform of the gizmo, NULL for none.
+ * @param[in]     color     Color of the gizmo.
+ *
+ * @note The topology of 'cube' is that of the accumulator.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_debug_draw_cube(
+	struct sg_debug_draw* draw,
+	struct sg_gizmo_cube_info const* cube,
+	struct sg_mat3x4 const* transform,
+	const uint32_t color
+);
+
+/**
+ * @brief Draw a gizmo capsule.
+ *
+ * @param[in out] draw      The accumulator.
+ * @param[in]     capsule   Information describing the gizmo.
+ * @param[in]     transform Transform of the gizmo, NULL for none.
+ * @param[in]     color     Color of the gizmo.
+ *
+ * @note The topology & subdivisions of 'capsule' are those of the accumulator.
+ *
+ * @return status code describing the result of evaluation.
+ */
+SG_API_EXPORT
+enum sg_status
+sg_debug_draw_capsule(
+	struct sg_debug_draw* draw,
+	struct sg_gizmo_capsule_info const* capsule,
+	struct sg_mat3x4 const* transform,
+	const uint32_t color
+);
+
+/** @}*/
+
+
+/** ***********************************************************
+ * Implementation
+ */
+#ifdef SIMPLE_GEOMETRY_IMPLEMENTATION
+
+/* Vector instruction sets are picked at compile time from the target flags,
+ * define SIMPLE_GEOMETRY_NO_SIMD to force the portable scalar paths.
+ */
+#ifndef SIMPLE_GEOMETRY_NO_SIMD
+#  if defined(__AVX2__)
+#    include <immintrin.h>
+#    define SG_SIMD_AVX2
+#    define SG_SIMD_SSE2
+#  elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define SG_SIMD_SSE2
+#  elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    include <arm_neon.h>
+#    define SG_SIMD_NEON
+#  endif
+#endif
+
+#ifdef SIMPLE_GEOMETRY_USE_PTHREADS
+#  include <pthread.h>
+#endif
+
+bool
+sg_success(const enum sg_status status)
+{
+	switch (status) {
+	case SG_OK_RETURNED_BUFFER:
+	case SG_OK_RETURNED_LENGTH:
+	case SG_OK_COPIED_TO_DST:
+		return true;
+	default:
+		return false;
+	};
+}
+	
+const char*
+sg_status_string(const enum sg_status status)
+{
+	switch (status) {
+	case SG_OK_RETURNED_BUFFER:                      return "SG_OK_RETURNED_BUFFER"; 
+	case SG_OK_RETURNED_LENGTH:                      return "SG_OK_RETURNED_LENGTH";
+	case SG_OK_COPIED_TO_DST:                        return "SG_OK_COPIED_TO_DST";
+	case SG_ERR_NULLPTR_INPUT:                       return "SG_ERR_NULLPTR_INPUT";
+	case SG_ERR_ZEROSIZE_INPUT:                      return "SG_ERR_ZEROSIZE_INPUT";
+	case SG_ERR_INFO_NOT_PROVIDED:                   return "SG_ERR_INFO_NOT_PROVIDED";
+	case SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1: return "SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1";
+	case SG_ERR_DSTLEN_NOT_PROVIDED:                 return "SG_ERR_DSTLEN_NOT_PROVIDED";
+	case SG_ERR_SRCBLKSIZE_LESSTHAN_SRCSTRIDE:       return "SG_ERR_SRCBLKSIZE_LESSTHAN_SRCSTRIDE";
+	case SG_ERR_SRCBLKSIZE_LESSTHAN_DSTSTRIDE:       return "SG_ERR_SRCBLKSIZE_LESSTHAN_DSTSTRIDE";
+	case SG_ERR_NOT_IMPLEMENTED_YET:                 return "SG_ERR_NOT_IMPLEMENTED_YET";
+	case SG_ERR_VERTICES_NOT_DIVISIBLE_BY_3:         return "SG_ERR_VERTICES_NOT_DIVISIBLE_BY_3";
+	case SG_ERR_INVALID_VERTEX_FORMAT:               return "SG_ERR_INVALID_VERTEX_FORMAT";
+	case SG_ERR_ALLOCATION_FAILED:                   return "SG_ERR_ALLOCATION_FAILED";
+	case SG_ERR_INVALID_RANGE:                       return "SG_ERR_INVALID_RANGE";
+	case SG_ERR_INVALID_TILE_SIZE:                   return "SG_ERR_INVALID_TILE_SIZE";
+	case SG_ERR_BUFFER_FULL:                         return "SG_ERR_BUFFER_FULL";
+	case SG_ERR_UNALIGNED_VERTEX_ATTRIBUTE:          return "SG_ERR_UNALIGNED_VERTEX_ATTRIBUTE";
+	};
+	return "SG_UNKNOWN_STATUS";
+}
+
+static inline void
+sg_memcpy_unchecked(
+	const unsigned char* src,
+	size_t n,
+	unsigned char* dst
+)
+{
+	size_t i;
+
+#if defined(SG_SIMD_AVX2)
+	if (n >= 64) {
+		/* Align the destination so the bulk of the stores are aligned. */
+		for (; ((uintptr_t)dst & 31) != 0; n--)
+			*dst++ = *src++;
+		for (; n >= 32; n -= 32, src += 32, dst += 32)
+			_mm256_store_si256((__m256i*)dst,
+			                   _mm256_loadu_si256((const __m256i*)src));
+	}
+#elif defined(SG_SIMD_SSE2)
+	if (n >= 32) {
+		for (; ((uintptr_t)dst & 15) != 0; n--)
+			*dst++ = *src++;
+		for (; n >= 16; n -= 16, src += 16, dst += 16)
+			_mm_store_si128((__m128i*)dst,
+			                _mm_loadu_si128((const __m128i*)src));
+	}
+#endif
+
+#if defined(SG_SIMD_SSE2)
+	for (; n >= 16; n -= 16, src += 16, dst += 16)
+		_mm_storeu_si128((__m128i*)dst, _mm_loadu_si128((const __m128i*)src));
+#elif defined(SG_SIMD_NEON)
+	for (; n >= 16; n -= 16, src += 16, dst += 16)
+		vst1q_u8(dst, vld1q_u8(src));
+#endif
+
+	/* Fixed 8 byte groups are merged into single word moves by the compiler,
+	 * without the aliasing issues of casting to a wider integer type.
+	 */
+	for (; n >= 8; n -= 8, src += 8, dst += 8) {
+		dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3];
+		dst[4] = src[4]; dst[5] = src[5]; dst[6] = src[6]; dst[7] = src[7];
+	}
+	for (i = 0; i < n; i++)
+		dst[i] = src[i];
+}
+
+enum sg_status
+sg_memcpy(
+	const void* src,
+	const size_t n,
+	void* dst
+)
+{
+	if (src == NULL || dst == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (n < 1)
+		return SG_ERR_ZEROSIZE_INPUT;
+
+	sg_memcpy_unchecked((const unsigned char*)src, n, (unsigned char*)dst);
+	return SG_OK_COPIED_TO_DST;
+}
+
+/* Fixed size block kernels, the constant trip counts let the compiler
+ * collapse each block into one or two register moves. Blocks go through a
+ * local copy so this holds without proving 'src' & 'dst' apart, which the
+ * compiler cannot do for the runtime strides of sg_interleave().
+ */
+#define SG_STRIDED_COPY_FIXED(BLOCK_SIZE)                             \
+	for (i = 0; i < block_count; i++) {                               \
+		unsigned char block[(BLOCK_SIZE)];                            \
+		for (k = 0; k < (BLOCK_SIZE); k++)                            \
+			block[k] = src[k];                                        \
+		for (k = 0; k < (BLOCK_SIZE); k++)                            \
+			dst[k] = block[k];                                        \
+		src += src_stride;                                            \
+		dst += dst_stride;                                            \
+	}
+
+static inline void
+sg_strided_copy_unchecked(
+	const unsigned char* src,
+	const size_t src_stride,
+	const size_t block_size,
+	const size_t block_count,
+	unsigned char* dst,
+	const size_t dst_stride
+)
+{
+	size_t i;
+	size_t k;
+
+	if (src_stride == block_size && dst_stride == block_size) {
+		sg_memcpy_unchecked(src, block_size * block_count, dst);
+		return;
+	}
+
+	switch (block_size) {
+	case 4:
+		SG_STRIDED_COPY_FIXED(4);
+		return;
+	case 8:
+		SG_STRIDED_COPY_FIXED(8);
+		return;
+	case 12:
+		SG_STRIDED_COPY_FIXED(12);
+		return;
+	case 16:
+#if defined(SG_SIMD_SSE2)
+		for (i = 0; i < block_count; i++) {
+			_mm_storeu_si128((__m128i*)dst, _mm_loadu_si128((const __m128i*)src));
+			src += src_stride;
+			dst += dst_stride;
+		}
+#elif defined(SG_SIMD_NEON)
+		for (i = 0; i < block_count; i++) {
+			vst1q_u8(dst, vld1q_u8(src));
+			src += src_stride;
+			dst += dst_stride;
+		}
+#else
+		SG_STRIDED_COPY_FIXED(16);
+#endif
+		return;
+	default:
+		for (i = 0; i < block_count; i++) {
+			sg_memcpy_unchecked(src, block_size, dst);
+			src += src_stride;
+			dst += dst_stride;
+		}
+		return;
+	}
+}
+
+#undef SG_STRIDED_COPY_FIXED
+
+enum sg_status
+sg_strided_blockcopy(
+	struct sg_strided_blockcopy_source_info const* source,
+	const size_t stride,
+	void* dst
+)
+{
+	if (source == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	if (source->ptr == NULL || dst == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (stride < 1 || source->block_size < 1 || source->block_count < 1)
+		return SG_ERR_ZEROSIZE_INPUT;
+	if (stride < source->block_size)
+		return SG_ERR_SRCBLKSIZE_LESSTHAN_DSTSTRIDE;
+
+	sg_strided_copy_unchecked((const unsigned char*)source->ptr,
+	                          source->stride,
+	                          source->block_size,
+	                          source->block_count,
+	                          (unsigned char*)dst,
+	                          stride);
+	return SG_OK_COPIED_TO_DST;
+}
+
+enum sg_status
+sg_interleave(
+	struct sg_interleave_source_info const* sources,
+	const size_t source_count,
+	const size_t block_count,
+	const size_t stride,
+	void* dst
+)
+{
+	size_t i;
+	size_t first;
+	size_t tile_length;
+	size_t tile_count;
+
+	if (sources == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	if (dst == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (source_count < 1 || block_count < 1 || stride < 1)
+		return SG_ERR_ZEROSIZE_INPUT;
+
+	for (i = 0; i < source_count; i++) {
+		if (sources[i].ptr == NULL)
+			return SG_ERR_NULLPTR_INPUT;
+		if (sources[i].block_size < 1)
+			return SG_ERR_ZEROSIZE_INPUT;
+		if (stride < sources[i].offset + sources[i].block_size)
+			return SG_ERR_SRCBLKSIZE_LESSTHAN_DSTSTRIDE;
+	}
+
+	tile_length = SG_INTERLEAVE_TILE_SIZE / stride;
+	if (tile_length < 1)
+		tile_length = 1;
+
+	for (first = 0; first < block_count; first += tile_length) {
+		tile_count = block_count - first;
+		if (tile_count > tile_length)
+			tile_count = tile_length;
+
+		for (i = 0; i < source_count; i++) {
+			sg_strided_copy_unchecked(
+				(const unsigned char*)sources[i].ptr + first * sources[i].stride,
+				sources[i].stride,
+				sources[i].block_size,
+				tile_count,
+				(unsigned char*)dst + first * stride + sources[i].offset,
+				stride);
+		}
+	}
+
+	return SG_OK_COPIED_TO_DST;
+}
+	
+struct sg_vec3f
+sg_vec3f_subtract(const struct sg_vec3f a, const struct sg_vec3f b)
+{
+	struct sg_vec3f v;
+	v.x = a.x - b.x;
+	v.y = a.y - b.y;
+	v.z = a.z - b.z;
+	return v;
+}
+
+struct sg_vec3f
+sg_vec3f_dividef(const struct sg_vec3f a, const float f)
+{
+	struct sg_vec3f v;
+	v.x = a.x / f;
+	v.y = a.y / f;
+	v.z = a.z / f;
+	return v;
+}
+
+struct sg_vec3f
+sg_vec3f_cross(const struct sg_vec3f a, const struct sg_vec3f b)
+{
+	struct sg_vec3f cross;
+	cross.x = a.y*b.z - a.z*b.y;
+	cross.y = a.z*b.x - a.x*b.z;
+	cross.z = a.x*b.y - a.y*b.x;
+	return cross;
+}
+
+float
+sg_vec3f_length(const struct sg_vec3f a)
+{
+	return SG_SQUARE_ROOT(a.x*a.x + a.y*a.y + a.z*a.z);
+}
+
+struct sg_vec3f
+sg_vec3f_normalize(const struct sg_vec3f a)
+{
+	float length;
+	length = sg_vec3f_length(a);
+	return sg_vec3f_dividef(a, length);
+}
+
+struct sg_vec3f
+sg_vec3f_from_position(const struct sg_position pos)
+{
+	return (struct sg_vec3f) {pos.x, pos.y, pos.z};
+}
+
 struct sg_normal
-sg_normal_from_vec3f(const struct sg_vec3f v);
+sg_normal_from_vec3f(const struct sg_vec3f v)
+{
+	return (struct sg_normal) {v.x, v.y, v.z};
+}
+
+struct sg_mat3x4
+sg_mat3x4_identity()
+{
+	return (struct sg_mat3x4) {{
+		{ 1.0f, 0.0f, 0.0f, 0.0f },
+		{ 0.0f, 1.0f, 0.0f, 0.0f },
+		{ 0.0f, 0.0f, 1.0f, 0.0f },
+	}};
+}
+
+struct sg_vec3f
+sg_mat3x4_transform_point(const struct sg_mat3x4 m, const struct sg_vec3f p)
+{
+	struct sg_vec3f v;
+	v.x = m.m[0][0]*p.x + m.m[0][1]*p.y + m.m[0][2]*p.z + m.m[0][3];
+	v.y = m.m[1][0]*p.x + m.m[1][1]*p.y + m.m[1][2]*p.z + m.m[1][3];
+	v.z = m.m[2][0]*p.x + m.m[2][1]*p.y + m.m[2][2]*p.z + m.m[2][3];
+	return v;
+}
+
+struct sg_mat3x4
+sg_mat3x4_from_trs(const struct sg_vec3f translation,
+				   const struct sg_quatf rotation,
+				   const struct sg_vec3f scale)
+{
+	const float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+	return (struct sg_mat3x4) {{
+		{ (1.0f - 2.0f*(y*y + z*z)) * scale.x, 2.0f*(x*y - w*z) * scale.y, 2.0f*(x*z + w*y) * scale.z, translation.x },
+		{ 2.0f*(x*y + w*z) * scale.x, (1.0f - 2.0f*(x*x + z*z)) * scale.y, 2.0f*(y*z - w*x) * scale.z, translation.y },
+		{ 2.0f*(x*z - w*y) * scale.x, 2.0f*(y*z + w*x) * scale.y, (1.0f - 2.0f*(x*x + y*y)) * scale.z, translation.z },
+	}};
+}
+
+struct sg_normal
+sg_face_normal(struct sg_position p1,
+			   struct sg_position p2,
+			   struct sg_position p3)
+{
+	struct sg_vec3f a;
+	struct sg_vec3f b;
+	struct sg_vec3f c;
+	struct sg_vec3f ba;
+	struct sg_vec3f ca;
+	struct sg_vec3f cross;
+
+	/* Calculate the face normal using the formula:
+	 * n = normalize(cross(b-a, c-a)) 
+	 */
+	a = sg_vec3f_from_position(p1);
+	b = sg_vec3f_from_position(p2);
+	c = sg_vec3f_from_position(p3);
+
+	ba = sg_vec3f_subtract(b, a); 
+	ca = sg_vec3f_subtract(c, a); 
+	cross = sg_vec3f_cross(ba, ca);
+	return sg_normal_from_vec3f(sg_vec3f_normalize(cross));
+}
+
+enum sg_status
+sg_calculate_flat_normals(
+	const struct sg_position* vertices,
+	const size_t vertices_length,
+	struct sg_normal* normals
+)
+{
+	struct sg_normal normal;
+	size_t i;
+
+	if (vertices == NULL || normals == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if ((vertices_length % 3) != 0)
+		return SG_ERR_VERTICES_NOT_DIVISIBLE_BY_3;
+
+	for (i = 0; i < vertices_length; i += 3) {
+		normal = sg_face_normal(vertices[i],
+								vertices[i+1],
+								vertices[i+2]);
+		
+		normals[i]   = normal;
+		normals[i+1] = normal;
+		normals[i+2] = normal;
+	}
+
+	return SG_OK_RETURNED_BUFFER;
+}
+
+#ifdef SG_MALLOC
+static void*
+sg_default_alloc(size_t size, void* user)
+{
+	(void)(user);
+	return SG_MALLOC(size);
+}
+
+static void
+sg_default_free(void* ptr, size_t size, void* user)
+{
+	(void)(size);
+	(void)(user);
+	SG_FREE(ptr);
+}
+
+struct sg_allocator
+sg_default_allocator()
+{
+	struct sg_allocator allocator;
+	allocator.alloc = sg_default_alloc;
+	allocator.free = sg_default_free;
+	allocator.user = NULL;
+	return allocator;
+}
+#endif
+
+static inline void
+sg_allocator_free(
+	struct sg_allocator const* allocator,
+	void* ptr,
+	const size_t size
+)
+{
+	if (ptr != NULL)
+		allocator->free(ptr, size, allocator->user);
+}
+
+enum sg_status
+sg_mesh_free(
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+)
+{
+	if (allocator == NULL || mesh == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (allocator->free == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+
+	sg_allocator_free(allocator, mesh->positions,
+	                  mesh->vertices_length * sizeof(mesh->positions[0]));
+	sg_allocator_free(allocator, mesh->normals,
+	                  mesh->vertices_length * sizeof(mesh->normals[0]));
+	sg_allocator_free(allocator, mesh->texcoords,
+	                  mesh->vertices_length * sizeof(mesh->texcoords[0]));
+	sg_allocator_free(allocator, mesh->indices,
+	                  mesh->indices_length * sizeof(mesh->indices[0]));
+
+	mesh->positions = NULL;
+	mesh->normals = NULL;
+	mesh->texcoords = NULL;
+	mesh->indices = NULL;
+	mesh->vertices_length = 0;
+	mesh->indices_length = 0;
+	return SG_OK_RETURNED_BUFFER;
+}
+
+static enum sg_status
+sg_mesh_allocate(
+	struct sg_allocator const* allocator,
+	const unsigned int attributes,
+	const size_t vertices_length,
+	const size_t indices_length,
+	struct sg_mesh* mesh
+)
+{
+	void* (*alloc)(size_t, void*) = allocator->alloc;
+	void* user = allocator->user;
+
+	mesh->positions = NULL;
+	mesh->normals = NULL;
+	mesh->texcoords = NULL;
+	mesh->indices = NULL;
+	mesh->vertices_length = vertices_length;
+	mesh->indices_length = indices_length;
+
+	if (attributes & SG_ATTRIBUTE_POSITION)
+		mesh->positions = (struct sg_position*)alloc(vertices_length * sizeof(mesh->positions[0]), user);
+	if (attributes & SG_ATTRIBUTE_NORMAL)
+		mesh->normals = (struct sg_normal*)alloc(vertices_length * sizeof(mesh->normals[0]), user);
+	if (attributes & SG_ATTRIBUTE_TEXCOORD)
+		mesh->texcoords = (struct sg_texcoord*)alloc(vertices_length * sizeof(mesh->texcoords[0]), user);
+	if (indices_length > 0)
+		mesh->indices = (SG_indice*)alloc(indices_length * sizeof(mesh->indices[0]), user);
+
+	if (((attributes & SG_ATTRIBUTE_POSITION) && mesh->positions == NULL)
+	    || ((attributes & SG_ATTRIBUTE_NORMAL) && mesh->normals == NULL)
+	    || ((attributes & SG_ATTRIBUTE_TEXCOORD) && mesh->texcoords == NULL)
+	    || (indices_length > 0 && mesh->indices == NULL)) {
+		sg_mesh_free(allocator, mesh);
+		return SG_ERR_ALLOCATION_FAILED;
+	}
+
+	return SG_OK_RETURNED_BUFFER;
+}
+
+static inline enum sg_status
+sg_generate_check(
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh const* mesh
+)
+{
+	if (allocator == NULL || mesh == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (allocator->alloc == NULL || allocator->free == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if ((attributes & SG_ATTRIBUTE_ALL) == 0)
+		return SG_ERR_ZEROSIZE_INPUT;
+	return SG_OK_RETURNED_BUFFER;
+}
+
+struct sg_vertex_stream {
+	unsigned char* ptr;           /// first attribute to write.
+	size_t stride;                /// stride between attributes.
+	enum sg_vertex_format format; /// component format of the attribute.
+};
+
+struct sg_vertex_streams {
+	struct sg_vertex_stream position;
+	struct sg_vertex_stream normal;
+	struct sg_vertex_stream texcoord;
+};
+
+static inline struct sg_vertex_stream
+sg_vertex_stream_from_array(void* array, const size_t element_size)
+{
+	struct sg_vertex_stream stream;
+	stream.ptr = (unsigned char*)array;
+	stream.stride = element_size;
+	stream.format = (array != NULL) ? SG_VERTEX_FORMAT_FLOAT32 : SG_VERTEX_FORMAT_NONE;
+	return stream;
+}
+
+static inline struct sg_vertex_streams
+sg_vertex_streams_from_arrays(
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_vertex_streams streams;
+	streams.position = sg_vertex_stream_from_array(positions, sizeof(positions[0]));
+	streams.normal = sg_vertex_stream_from_array(normals, sizeof(normals[0]));
+	streams.texcoord = sg_vertex_stream_from_array(texcoords, sizeof(texcoords[0]));
+	return streams;
+}
+
+static inline enum sg_status
+sg_vertex_stream_from_attribute(
+	void* buffer,
+	struct sg_vertex_attribute const* attribute,
+	const enum sg_vertex_format packed_format,
+	struct sg_vertex_stream* stream
+)
+{
+	stream->ptr = NULL;
+	stream->stride = attribute->stride;
+	stream->format = attribute->format;
+
+	if (attribute->format == SG_VERTEX_FORMAT_NONE)
+		return SG_OK_RETURNED_BUFFER;
+	if (attribute->format != SG_VERTEX_FORMAT_FLOAT32 && attribute->format != packed_format)
+		return SG_ERR_INVALID_VERTEX_FORMAT;
+	if (attribute->stride < 1)
+		return SG_ERR_ZEROSIZE_INPUT;
+
+	// The stores write whole components, every attribute address must be
+	// aligned to the component size.
+	const size_t alignment = (attribute->format == SG_VERTEX_FORMAT_FLOAT32) ? sizeof(float) : sizeof(int16_t);
+	if ((((uintptr_t)buffer + attribute->offset) | attribute->stride) % alignment != 0)
+		return SG_ERR_UNALIGNED_VERTEX_ATTRIBUTE;
+
+	stream->ptr = (unsigned char*)buffer + attribute->offset;
+	return SG_OK_RETURNED_BUFFER;
+}
+
+static enum sg_status
+sg_vertex_streams_from_layout(
+	struct sg_vertex_layout const* layout,
+	struct sg_vertex_streams* streams
+)
+{
+	enum sg_status status;
+
+	/* Positions are not normalized, so only the float format applies. */
+	status = sg_vertex_stream_from_attribute(layout->buffer, &layout->position,
+	                                         SG_VERTEX_FORMAT_FLOAT32,
+	                                         &streams->position);
+	if (!sg_success(status))
+		return status;
+	status = sg_vertex_stream_from_attribute(layout->buffer, &layout->normal,
+	                                         SG_VERTEX_FORMAT_SNORM16,
+	                                         &streams->normal);
+	if (!sg_success(status))
+		return status;
+	return sg_vertex_stream_from_attribute(layout->buffer, &layout->texcoord,
+	                                       SG_VERTEX_FORMAT_UNORM16,
+	                                       &streams->texcoord);
+}
+
+static inline int16_t
+sg_pack_snorm16(float v)
+{
+	v = (v < -1.0f) ? -1.0f : (v > 1.0f) ? 1.0f : v;
+	return (int16_t)(v * 32767.0f + ((v < 0.0f) ? -0.5f : 0.5f));
+}
+
+static inline uint16_t
+sg_pack_unorm16(float v)
+{
+	v = (v < 0.0f) ? 0.0f : (v > 1.0f) ? 1.0f : v;
+	return (uint16_t)(v * 65535.0f + 0.5f);
+}
+
+/* Streams are aligned to their component size, checked by
+ * sg_vertex_stream_from_attribute() for layouts, so the stores below write
+ * through the component type directly.
+ */
+static inline void
+sg_vertex_stream_store3(
+	struct sg_vertex_stream const* stream,
+	const size_t index,
+	const float x,
+	const float y,
+	const float z
+)
+{
+	unsigned char* dst;
+
+	// Skipped attributes have no buffer to form an address in.
+	if (stream->format == SG_VERTEX_FORMAT_NONE)
+		return;
+
+	dst = stream->ptr + index * stream->stride;
+	switch (stream->format) {
+	case SG_VERTEX_FORMAT_FLOAT32:
+		((float*)dst)[0] = x;
+		((float*)dst)[1] = y;
+		((float*)dst)[2] = z;
+		return;
+	case SG_VERTEX_FORMAT_SNORM16:
+		((int16_t*)dst)[0] = sg_pack_snorm16(x);
+		((int16_t*)dst)[1] = sg_pack_snorm16(y);
+		((int16_t*)dst)[2] = sg_pack_snorm16(z);
+		return;
+	default:
+		return;
+	}
+}
+
+static inline void
+sg_vertex_stream_store2(
+	struct sg_vertex_stream const* stream,
+	const size_t index,
+	const float u,
+	const float v
+)
+{
+	unsigned char* dst;
+
+	// Skipped attributes have no buffer to form an address in.
+	if (stream->format == SG_VERTEX_FORMAT_NONE)
+		return;
+
+	dst = stream->ptr + index * stream->stride;
+	switch (stream->format) {
+	case SG_VERTEX_FORMAT_FLOAT32:
+		((float*)dst)[0] = u;
+		((float*)dst)[1] = v;
+		return;
+	case SG_VERTEX_FORMAT_UNORM16:
+		((uint16_t*)dst)[0] = sg_pack_unorm16(u);
+		((uint16_t*)dst)[1] = sg_pack_unorm16(v);
+		return;
+	default:
+		return;
+	}
+}
+
+/* Store a row of attributes sharing their y component, with the format
+ * dispatched once for the whole row instead of once per attribute.
+ */
+static void
+sg_vertex_stream_store_row3(
+	struct sg_vertex_stream const* stream,
+	const size_t first,
+	const float* x,
+	const float y,
+	const float* z,
+	const size_t count
+)
+{
+	const size_t stride = stream->stride;
+	unsigned char* dst;
+	size_t i;
+
+	// Skipped attributes have no buffer to form an address in.
+	if (stream->format == SG_VERTEX_FORMAT_NONE)
+		return;
+
+	dst = stream->ptr + first * stride;
+	switch (stream->format) {
+	case SG_VERTEX_FORMAT_FLOAT32:
+		for (i = 0; i < count; i++, dst += stride) {
+			((float*)dst)[0] = x[i];
+			((float*)dst)[1] = y;
+			((float*)dst)[2] = z[i];
+		}
+		return;
+	case SG_VERTEX_FORMAT_SNORM16: {
+		const int16_t packed_y = sg_pack_snorm16(y);
+		for (i = 0; i < count; i++, dst += stride) {
+			((int16_t*)dst)[0] = sg_pack_snorm16(x[i]);
+			((int16_t*)dst)[1] = packed_y;
+			((int16_t*)dst)[2] = sg_pack_snorm16(z[i]);
+		}
+		return;
+	}
+	default:
+		return;
+	}
+}
+
+static void
+sg_vertex_stream_store_row2(
+	struct sg_vertex_stream const* stream,
+	const size_t first,
+	const float* u,
+	const float v,
+	const size_t count
+)
+{
+	const size_t stride = stream->stride;
+	unsigned char* dst;
+	size_t i;
+
+	// Skipped attributes have no buffer to form an address in.
+	if (stream->format == SG_VERTEX_FORMAT_NONE)
+		return;
+
+	dst = stream->ptr + first * stride;
+	switch (stream->format) {
+	case SG_VERTEX_FORMAT_FLOAT32:
+		for (i = 0; i < count; i++, dst += stride) {
+			((float*)dst)[0] = u[i];
+			((float*)dst)[1] = v;
+		}
+		return;
+	case SG_VERTEX_FORMAT_UNORM16: {
+		const uint16_t packed_v = sg_pack_unorm16(v);
+		for (i = 0; i < count; i++, dst += stride) {
+			((uint16_t*)dst)[0] = sg_pack_unorm16(u[i]);
+			((uint16_t*)dst)[1] = packed_v;
+		}
+		return;
+	}
+	default:
+		return;
+	}
+}
+
+static inline void
+sg_store_position(struct sg_vertex_streams const* streams,
+                  const size_t index,
+                  const struct sg_position p)
+{
+	sg_vertex_stream_store3(&streams->position, index, p.x, p.y, p.z);
+}
+
+static inline void
+sg_store_normal(struct sg_vertex_streams const* streams,
+                const size_t index,
+                const struct sg_normal n)
+{
+	sg_vertex_stream_store3(&streams->normal, index, n.x, n.y, n.z);
+}
+
+static inline void
+sg_store_texcoord(struct sg_vertex_streams const* streams,
+                  const size_t index,
+                  const struct sg_texcoord t)
+{
+	sg_vertex_stream_store2(&streams->texcoord, index, t.u, t.v);
+}
+
+/* The unit circle sampled at the sectors of a ring, built once per call so
+ * that generators only pay for 2 transcendentals per subdivision.
+ * Entry subdivisions is entry 0, so closing sectors meet exactly.
+ */
+struct sg_ring_table {
+	size_t subdivisions;
+	float step;
+	float cos[SG_RING_TABLE_CAPACITY + 1];
+	float sin[SG_RING_TABLE_CAPACITY + 1];
+};
+
+/* Sample sector of a ring, the closing sector is exactly the first one. */
+static inline void
+sg_ring_sample(
+	const size_t subdivisions,
+	const float step,
+	const size_t sector,
+	float* cos_angle,
+	float* sin_angle
+)
+{
+	if (sector == 0 || sector == subdivisions) {
+		*cos_angle = 1.0f;
+		*sin_angle = 0.0f;
+		return;
+	}
+	*cos_angle = SG_COS(sector * step);
+	*sin_angle = SG_SIN(sector * step);
+}
+
+static void
+sg_ring_table_init(struct sg_ring_table* table, const size_t subdivisions)
+{
+	table->subdivisions = subdivisions;
+	table->step = 2 * SG_PI / subdivisions;
+	if (subdivisions > SG_RING_TABLE_CAPACITY)
+		return;
+
+	for (size_t i = 0; i <= subdivisions; i++)
+		sg_ring_sample(subdivisions, table->step, i, &table->cos[i], &table->sin[i]);
+}
+
+/* Sectors up to 2 * subdivisions are accepted, so arcs may cross the seam. */
+static inline float
+sg_ring_cos(struct sg_ring_table const* table, size_t sector)
+{
+	if (sector > table->subdivisions)
+		sector -= table->subdivisions;
+	if (table->subdivisions > SG_RING_TABLE_CAPACITY)
+		return (sector == table->subdivisions) ? 1.0f : SG_COS(sector * table->step);
+	return table->cos[sector];
+}
+
+static inline float
+sg_ring_sin(struct sg_ring_table const* table, size_t sector)
+{
+	if (sector > table->subdivisions)
+		sector -= table->subdivisions;
+	if (table->subdivisions > SG_RING_TABLE_CAPACITY)
+		return (sector == table->subdivisions) ? 0.0f : SG_SIN(sector * table->step);
+	return table->sin[sector];
+}
+
+#define SG_PLANE_ROW_TILE 64
+
+static void
+sg_indexed_plane_write_rows(
+	struct sg_indexed_plane_info const* plane,
+	const size_t first_row,
+	const size_t last_row,
+	struct sg_vertex_streams const* streams
+)
+{
+	const size_t row_length = plane->width_subdivisions;
+	const float width_scale = plane->width / (plane->width_subdivisions - 1);
+	const float depth_scale = plane->depth / (plane->depth_subdivisions - 1);
+	const float u_scale = 1.0f / (plane->width_subdivisions - 1);
+	const float v_scale = 1.0f / (plane->depth_subdivisions - 1);
+
+	float positions_x[SG_PLANE_ROW_TILE];
+	float texcoords_u[SG_PLANE_ROW_TILE];
+	float zeros[SG_PLANE_ROW_TILE];
+	float ones[SG_PLANE_ROW_TILE];
+
+	for (size_t j = 0; j < SG_PLANE_ROW_TILE; j++) {
+		zeros[j] = 0.0f;
+		ones[j] = 1.0f;
+	}
+
+	// All streams being float32 is by far the common case, it is written in a
+	// single pass keeping the writes to the different streams close together.
+	if (streams->position.format == SG_VERTEX_FORMAT_FLOAT32
+	    && streams->normal.format == SG_VERTEX_FORMAT_FLOAT32
+	    && streams->texcoord.format == SG_VERTEX_FORMAT_FLOAT32) {
+		const size_t position_stride = streams->position.stride;
+		const size_t normal_stride = streams->normal.stride;
+		const size_t texcoord_stride = streams->texcoord.stride;
+
+		for (size_t d = first_row; d < last_row; d++) {
+			const float position_y = depth_scale * d;
+			const float texcoord_v = v_scale * d;
+			unsigned char* position = streams->position.ptr + d * row_length * position_stride;
+			unsigned char* normal = streams->normal.ptr + d * row_length * normal_stride;
+			unsigned char* texcoord = streams->texcoord.ptr + d * row_length * texcoord_stride;
+
+			for (size_t w = 0; w < row_length; w++) {
+				((float*)position)[0] = width_scale * w;
+				((float*)position)[1] = position_y;
+				((float*)position)[2] = 0.0f;
+				((float*)normal)[0] = 0.0f;
+				((float*)normal)[1] = 0.0f;
+				((float*)normal)[2] = 1.0f;
+				((float*)texcoord)[0] = u_scale * w;
+				((float*)texcoord)[1] = texcoord_v;
+				position += position_stride;
+				normal += normal_stride;
+				texcoord += texcoord_stride;
+			}
+		}
+		return;
+	}
+
+	for (size_t d = first_row; d < last_row; d++) {
+		const float position_y = depth_scale * d;
+		const float texcoord_v = v_scale * d;
+
+		for (size_t first = 0; first < row_length; first += SG_PLANE_ROW_TILE) {
+			const size_t n = d * row_length + first;
+			const size_t count = (row_length - first < SG_PLANE_ROW_TILE)
+				? row_length - first
+				: SG_PLANE_ROW_TILE;
+
+			for (size_t j = 0; j < count; j++) {
+				positions_x[j] = width_scale * (first + j);
+				texcoords_u[j] = u_scale * (first + j);
+			}
+
+			sg_vertex_stream_store_row3(&streams->position, n,
+			                            positions_x, position_y, zeros, count);
+			sg_vertex_stream_store_row3(&streams->normal, n,
+			                            zeros, 0.0f, ones, count);
+			sg_vertex_stream_store_row2(&streams->texcoord, n,
+			                            texcoords_u, texcoord_v, count);
+		}
+	}
+}
+
+static void
+sg_indexed_plane_write(
+	struct sg_indexed_plane_info const* plane,
+	struct sg_vertex_streams const* streams
+)
+{
+	sg_indexed_plane_write_rows(plane, 0, plane->depth_subdivisions, streams);
+}
+
+static enum sg_status
+sg_indexed_plane_streams(
+	struct sg_indexed_plane_info const* plane,
+	size_t* length,
+	struct sg_vertex_streams const* streams
+)
+{
+	if (plane == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+	if (plane->width_subdivisions < 2 || plane->depth_subdivisions < 2)
+		return SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1;
+
+	if (streams == NULL) {
+		*length = plane->width_subdivisions * plane->depth_subdivisions;
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	sg_indexed_plane_write(plane, streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_plane_vertices(
+	struct sg_indexed_plane_info const* plane,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_vertex_streams streams;
+
+	if (positions == NULL && normals == NULL && texcoords == NULL)
+		return sg_indexed_plane_streams(plane, length, NULL);
+
+	streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	return sg_indexed_plane_streams(plane, length, &streams);
+}
+
+enum sg_status
+sg_indexed_plane_vertices_layout(
+	struct sg_indexed_plane_info const* plane,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+)
+{
+	struct sg_vertex_streams streams;
+	enum sg_status status;
+
+	if (layout == NULL || layout->buffer == NULL)
+		return sg_indexed_plane_streams(plane, length, NULL);
+
+	status = sg_vertex_streams_from_layout(layout, &streams);
+	if (!sg_success(status))
+		return status;
+	return sg_indexed_plane_streams(plane, length, &streams);
+}
+
+enum sg_status
+sg_indexed_plane_vertices_range(
+	struct sg_indexed_plane_info const* plane,
+	const size_t first_row,
+	const size_t last_row,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_vertex_streams streams;
+
+	if (plane == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	if (plane->width_subdivisions < 2 || plane->depth_subdivisions < 2)
+		return SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1;
+	if (positions == NULL && normals == NULL && texcoords == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (first_row >= last_row || last_row > plane->depth_subdivisions)
+		return SG_ERR_INVALID_RANGE;
+
+	streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	sg_indexed_plane_write_rows(plane, first_row, last_row, &streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+/* Whether every vertex of a 'columns' by 'rows' grid can be indexed by an
+ * SG_indice, that is whether the last vertex 'columns * rows - 1' fits.
+ * Written to not overflow, for any width of SG_indice.
+ */
+static inline bool
+sg_indices_fit_grid(const size_t columns, const size_t rows)
+{
+	const size_t max = (size_t)SG_INDICE_MAX;
+	if (columns == 0 || rows == 0)
+		return true;
+	return rows - 1 <= max && columns - 1 <= (max - (rows - 1)) / rows;
+}
+
+/* Widest strip for which every vertex only misses a FIFO vertex cache of
+ * 'cache_size' once. While a row of the strip is drawn, the cache must hold
+ * the 'strip_width + 1' vertices of the row above, the ones of the row
+ * below and the next vertex, so 2 * (strip_width + 1) + 1 <= cache_size.
+ */
+static size_t
+sg_plane_strip_width(struct sg_indexed_plane_info const* plane)
+{
+	const size_t quads_wide = plane->width_subdivisions - 1;
+	size_t strip_width;
+
+	if (plane->cache_size == 0)
+		return quads_wide;
+
+	strip_width = (plane->cache_size < 5) ? 1 : (plane->cache_size - 3) / 2;
+	return (strip_width < quads_wide) ? strip_width : quads_wide;
+}
+
+static void
+sg_indexed_plane_write_index_rows(
+	struct sg_indexed_plane_info const* plane,
+	const size_t first_row,
+	const size_t last_row,
+	SG_indice* indices
+)
+{
+	const size_t row_length = plane->width_subdivisions;
+	const size_t quads_wide = row_length - 1;
+	const size_t quads_deep = plane->depth_subdivisions - 1;
+	const size_t strip_width = sg_plane_strip_width(plane);
+
+	for (size_t first = 0; first < quads_wide; first += strip_width) {
+		const size_t last = (quads_wide - first < strip_width)
+			? quads_wide
+			: first + strip_width;
+		// Strips are stored one after the other, each row by row.
+		const size_t strip_offset = first * quads_deep * 6;
+
+		for (size_t d = first_row; d < last_row; d++) {
+			size_t n = strip_offset + d * (last - first) * 6;
+			for (size_t w = first; w < last; w++) {
+				const SG_indice a = (SG_indice)(d * row_length + w);
+				const SG_indice b = a + 1;
+				const SG_indice c = (SG_indice)(a + row_length);
+				const SG_indice e = c + 1;
+
+				indices[n++] = a;
+				indices[n++] = b;
+				indices[n++] = e;
+
+				indices[n++] = a;
+				indices[n++] = e;
+				indices[n++] = c;
+			}
+		}
+	}
+}
+
+static inline enum sg_status
+sg_indexed_plane_indices_check(struct sg_indexed_plane_info const* plane)
+{
+	if (plane == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	if (plane->width_subdivisions < 2 || plane->depth_subdivisions < 2)
+		return SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1;
+	if (!sg_indices_fit_grid(plane->width_subdivisions, plane->depth_subdivisions))
+		return SG_ERR_INVALID_RANGE;
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_plane_indices(
+	struct sg_indexed_plane_info const* plane,
+	size_t* length,
+	SG_indice* indices
+)
+{
+	enum sg_status status;
+
+	status = sg_indexed_plane_indices_check(plane);
+	if (!sg_success(status))
+		return status;
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	if (indices == NULL) {
+		*length = (plane->width_subdivisions - 1) * (plane->depth_subdivisions - 1) * 6;
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	sg_indexed_plane_write_index_rows(plane, 0, plane->depth_subdivisions - 1, indices);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_plane_indices_range(
+	struct sg_indexed_plane_info const* plane,
+	const size_t first_row,
+	const size_t last_row,
+	SG_indice* indices
+)
+{
+	enum sg_status status;
+
+	status = sg_indexed_plane_indices_check(plane);
+	if (!sg_success(status))
+		return status;
+	if (indices == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (first_row >= last_row || last_row > plane->depth_subdivisions - 1)
+		return SG_ERR_INVALID_RANGE;
+
+	sg_indexed_plane_write_index_rows(plane, first_row, last_row, indices);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_plane_generate(
+	struct sg_indexed_plane_info const* plane,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+)
+{
+	struct sg_vertex_streams streams;
+	size_t vertices_length;
+	size_t indices_length = 0;
+	enum sg_status status;
+
+	status = sg_generate_check(attributes, allocator, mesh);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_indexed_plane_streams(plane, &vertices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_indexed_plane_indices(plane, &indices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_mesh_allocate(allocator, attributes, vertices_length, indices_length, mesh);
+	if (!sg_success(status))
+		return status;
+
+	streams = sg_vertex_streams_from_arrays(mesh->positions, mesh->normals, mesh->texcoords);
+	sg_indexed_plane_write(plane, &streams);
+	sg_indexed_plane_indices(plane, &indices_length, mesh->indices);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+#define SG_HEIGHTFIELD_TILE 64
+
+/* Scaled heights of 'count' vertices of row d, every 'step'th one starting
+ * at column first.
+ */
+static inline void
+sg_heightfield_sample_row(
+	struct sg_heightfield_info const* heightfield,
+	const size_t d,
+	const size_t first,
+	const size_t step,
+	const size_t count,
+	float* heights
+)
+{
+	const float scale = heightfield->height_scale;
+
+	if (heightfield->heights != NULL) {
+		const float* row = heightfield->heights
+			+ d * heightfield->plane.width_subdivisions + first;
+		if (step == 1) {
+			for (size_t j = 0; j < count; j++)
+				heights[j] = row[j] * scale;
+		} else {
+			for (size_t j = 0; j < count; j++)
+				heights[j] = row[j * step] * scale;
+		}
+		return;
+	}
+	for (size_t j = 0; j < count; j++)
+		heights[j] = heightfield->sample(first + j * step, d, heightfield->user) * scale;
+}
+
+/* Write a window of 'columns' x 'rows' vertices of the heightfield grid,
+ * starting at vertex (first_w, first_d) and taking every 'step'th vertex
+ * along both axes. Vertex (c, r) of the window is stored at
+ * r * columns + c.
+ *
+ * Columns are generated in tiles, walking down the rows of a tile with the
+ * rows above and below kept around while later rows still need them, so
+ * a dense window samples every height once per tile. Normals always use
+ * the differences to the directly neighbouring grid vertices, so a vertex
+ * comes out the same whichever window it is generated in.
+ */
+static void
+sg_heightfield_write_window(
+	struct sg_heightfield_info const* heightfield,
+	const size_t first_w,
+	const size_t first_d,
+	const size_t step,
+	const size_t columns,
+	const size_t rows,
+	struct sg_vertex_streams const* streams
+)
+{
+	struct sg_indexed_plane_info const* plane = &heightfield->plane;
+	const size_t row_length = plane->width_subdivisions;
+	const size_t row_count = plane->depth_subdivisions;
+	const float width_scale = plane->width / (plane->width_subdivisions - 1);
+	const float depth_scale = plane->depth / (plane->depth_subdivisions - 1);
+	const float u_scale = 1.0f / (plane->width_subdivisions - 1);
+	const float v_scale = 1.0f / (plane->depth_subdivisions - 1);
+
+	// Samples of three rows along the columns of the tile, with a column of
+	// margin on each side holding the horizontal neighbours of a dense window.
+	float samples[3][SG_HEIGHTFIELD_TILE + 2];
+	size_t sampled[3];
+	float left[SG_HEIGHTFIELD_TILE];
+	float right[SG_HEIGHTFIELD_TILE];
+	float positions_x[SG_HEIGHTFIELD_TILE];
+	float texcoords_u[SG_HEIGHTFIELD_TILE];
+
+	for (size_t first = 0; first < columns; first += SG_HEIGHTFIELD_TILE) {
+		const size_t count = (columns - first < SG_HEIGHTFIELD_TILE)
+			? columns - first
+			: SG_HEIGHTFIELD_TILE;
+		const size_t tile_first = first_w + first * step;
+		const size_t tile_last = tile_first + (count - 1) * step;
+		// Neighbouring columns are clamped to the edges of the plane.
+		const size_t margin_before = (step == 1 && tile_first > 0) ? 1 : 0;
+		const size_t margin_after = (step == 1 && tile_last + 1 < row_length) ? 1 : 0;
+		const size_t margin_count = margin_before + count + margin_after;
+		const float* left_heights;
+		const float* right_heights;
+
+		for (size_t j = 0; j < count; j++) {
+			positions_x[j] = width_scale * (tile_first + j * step);
+			texcoords_u[j] = u_scale * (tile_first + j * step);
+		}
+
+		for (size_t slot = 0; slot < 3; slot++)
+			sampled[slot] = (size_t)-1;
+
+		for (size_t r = 0; r < rows; r++) {
+			const size_t d = first_d + r * step;
+			const size_t n = r * columns + first;
+			const float position_y = depth_scale * d;
+			const float texcoord_v = v_scale * d;
+			// The first & last rows are their own upper & lower neighbours.
+			const size_t needed[3] = {
+				(d > 0) ? d - 1 : d,
+				d,
+				(d + 1 < row_count) ? d + 1 : d
+			};
+			const float dy = depth_scale * (float)(needed[2] - needed[0]);
+			float* row[3];
+
+			for (size_t k = 0; k < 3; k++) {
+				size_t slot = 0;
+				while (slot < 3 && sampled[slot] != needed[k])
+					slot++;
+				if (slot == 3) {
+					// Take over a slot holding none of the needed rows.
+					slot = 0;
+					while (sampled[slot] == needed[0] || sampled[slot] == needed[1]
+					       || sampled[slot] == needed[2])
+						slot++;
+					sg_heightfield_sample_row(heightfield, needed[k], tile_first - margin_before,
+					                          step, margin_count, samples[slot] + 1 - margin_before);
+					// Clamped margins repeat the edge sample.
+					if (!margin_before)
+						samples[slot][0] = samples[slot][1];
+					if (!margin_after)
+						samples[slot][count + 1] = samples[slot][count];
+					sampled[slot] = needed[k];
+				}
+				row[k] = samples[slot] + 1;
+			}
+
+			sg_vertex_stream_store_row3(&streams->position, n,
+			                            positions_x, position_y, row[1], count);
+			sg_vertex_stream_store_row2(&streams->texcoord, n,
+			                            texcoords_u, texcoord_v, count);
+
+			if (streams->normal.format == SG_VERTEX_FORMAT_NONE)
+				continue;
+
+			// Horizontal neighbours of a sparse window are sampled apart,
+			// clamped at the edges of the plane.
+			if (step == 1) {
+				left_heights = row[1] - 1;
+				right_heights = row[1] + 1;
+			} else {
+				const size_t left_first = (tile_first > 0) ? 0 : 1;
+				const size_t right_count = (tile_last + 1 < row_length) ? count : count - 1;
+				left[0] = row[1][0];
+				right[count - 1] = row[1][count - 1];
+				sg_heightfield_sample_row(heightfield, d, tile_first + left_first * step - 1,
+				                          step, count - left_first, left + left_first);
+				sg_heightfield_sample_row(heightfield, d, tile_first + 1,
+				                          step, right_count, right);
+				left_heights = left;
+				right_heights = right;
+			}
+
+			for (size_t j = 0; j < count; j++) {
+				const size_t w = tile_first + j * step;
+				const size_t left_w = (w > 0) ? w - 1 : w;
+				const size_t right_w = (w + 1 < row_length) ? w + 1 : w;
+				const float dx = width_scale * (float)(right_w - left_w);
+				const float dz_dx = (right_heights[j] - left_heights[j]) / dx;
+				const float dz_dy = (row[2][j] - row[0][j]) / dy;
+				const float inverse_length = 1.0f / SG_SQUARE_ROOT(dz_dx * dz_dx + dz_dy * dz_dy + 1.0f);
+				const struct sg_normal normal{
+					.x = -dz_dx * inverse_length,
+					.y = -dz_dy * inverse_length,
+					.z = inverse_length
+				};
+				sg_store_normal(streams, n + j, normal);
+			}
+		}
+	}
+}
+
+static void
+sg_heightfield_write(
+	struct sg_heightfield_info const* heightfield,
+	struct sg_vertex_streams const* streams
+)
+{
+	sg_heightfield_write_window(heightfield, 0, 0, 1,
+	                            heightfield->plane.width_subdivisions,
+	                            heightfield->plane.depth_subdivisions,
+	                            streams);
+}
+
+static enum sg_status
+sg_heightfield_streams(
+	struct sg_heightfield_info const* heightfield,
+	size_t* length,
+	struct sg_vertex_streams const* streams
+)
+{
+	enum sg_status status;
+
+	if (heightfield == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	status = sg_indexed_plane_streams(&heightfield->plane, length, NULL);
+	if (!sg_success(status) || streams == NULL)
+		return status;
+
+	if (heightfield->heights == NULL && heightfield->sample == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+
+	sg_heightfield_write(heightfield, streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_heightfield_vertices(
+	struct sg_heightfield_info const* heightfield,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_vertex_streams streams;
+
+	if (positions == NULL && normals == NULL && texcoords == NULL)
+		return sg_heightfield_streams(heightfield, length, NULL);
+
+	streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	return sg_heightfield_streams(heightfield, length, &streams);
+}
+
+enum sg_status
+sg_heightfield_vertices_layout(
+	struct sg_heightfield_info const* heightfield,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+)
+{
+	struct sg_vertex_streams streams;
+	enum sg_status status;
+
+	if (layout == NULL || layout->buffer == NULL)
+		return sg_heightfield_streams(heightfield, length, NULL);
+
+	status = sg_vertex_streams_from_layout(layout, &streams);
+	if (!sg_success(status))
+		return status;
+	return sg_heightfield_streams(heightfield, length, &streams);
+}
+
+/* Validate a tile and return the amount of quads along its sides. */
+static enum sg_status
+sg_terrain_tile_check(
+	struct sg_terrain_tile_info const* tile,
+	size_t* quads
+)
+{
+	struct sg_indexed_plane_info const* plane;
+	const size_t step = (size_t)1 << tile->lod;
+
+	if (tile->heightfield == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	plane = &tile->heightfield->plane;
+	if (plane->width_subdivisions < 2 || plane->depth_subdivisions < 2)
+		return SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1;
+	if (tile->tile_size == 0 || tile->tile_size % step != 0)
+		return SG_ERR_INVALID_TILE_SIZE;
+	if (tile->stitch_edges != 0 && tile->tile_size % (step * 2) != 0)
+		return SG_ERR_INVALID_TILE_SIZE;
+	if ((plane->width_subdivisions - 1) % tile->tile_size != 0
+	    || (plane->depth_subdivisions - 1) % tile->tile_size != 0)
+		return SG_ERR_INVALID_TILE_SIZE;
+	if (tile->tile_x >= (plane->width_subdivisions - 1) / tile->tile_size
+	    || tile->tile_y >= (plane->depth_subdivisions - 1) / tile->tile_size)
+		return SG_ERR_INVALID_RANGE;
+
+	*quads = tile->tile_size / step;
+	return SG_OK_RETURNED_BUFFER;
+}
+
+/* Move the odd vertices of the stitched edges halfway between their even
+ * neighbours, onto the edge of the coarser neighbouring tile, reading back
+ * the generated vertices.
+ */
+static void
+sg_terrain_tile_stitch(
+	struct sg_terrain_tile_info const* tile,
+	const size_t quads,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	static const unsigned int edges[4] = {
+		SG_TILE_EDGE_SOUTH, SG_TILE_EDGE_NORTH, SG_TILE_EDGE_WEST, SG_TILE_EDGE_EAST
+	};
+	const size_t side = quads + 1;
+
+	for (size_t edge = 0; edge < 4; edge++) {
+		if (!(tile->stitch_edges & edges[edge]))
+			continue;
+
+		const size_t first = (edge == 0) ? 0
+			: (edge == 1) ? quads * side
+			: (edge == 2) ? 0
+			: quads;
+		const size_t along = (edge < 2) ? 1 : side;
+
+		for (size_t k = 1; k < quads; k += 2) {
+			const size_t n = first + k * along;
+			const size_t n0 = n - along;
+			const size_t n1 = n + along;
+
+			if (positions != NULL) {
+				positions[n].x = (positions[n0].x + positions[n1].x) * 0.5f;
+				positions[n].y = (positions[n0].y + positions[n1].y) * 0.5f;
+				positions[n].z = (positions[n0].z + positions[n1].z) * 0.5f;
+			}
+			if (normals != NULL) {
+				const float x = normals[n0].x + normals[n1].x;
+				const float y = normals[n0].y + normals[n1].y;
+				const float z = normals[n0].z + normals[n1].z;
+				const float inverse_length = 1.0f / SG_SQUARE_ROOT(x * x + y * y + z * z);
+				normals[n].x = x * inverse_length;
+				normals[n].y = y * inverse_length;
+				normals[n].z = z * inverse_length;
+			}
+			if (texcoords != NULL) {
+				texcoords[n].u = (texcoords[n0].u + texcoords[n1].u) * 0.5f;
+				texcoords[n].v = (texcoords[n0].v + texcoords[n1].v) * 0.5f;
+			}
+		}
+	}
+}
+
+/* Copy the tile edges below the tile as skirts, reading back the generated
+ * edge vertices so that stitching applies to the skirts as well.
+ */
+static void
+sg_terrain_tile_write_skirts(
+	struct sg_terrain_tile_info const* tile,
+	const size_t quads,
+	struct sg_position const* positions,
+	struct sg_normal const* normals,
+	struct sg_texcoord const* texcoords,
+	struct sg_vertex_streams const* streams
+)
+{
+	const size_t side = quads + 1;
+	size_t n = side * side;
+
+	for (size_t edge = 0; edge < 4; edge++) {
+		for (size_t k = 0; k < side; k++) {
+			// south, north, west & east edges.
+			const size_t source = (edge == 0) ? k
+				: (edge == 1) ? quads * side + k
+				: (edge == 2) ? k * side
+				: k * side + quads;
+
+			if (positions != NULL) {
+				struct sg_position position = positions[source];
+				position.z -= tile->skirt_depth;
+				sg_store_position(streams, n, position);
+			}
+			if (normals != NULL)
+				sg_store_normal(streams, n, normals[source]);
+			if (texcoords != NULL)
+				sg_store_texcoord(streams, n, texcoords[source]);
+			n++;
+		}
+	}
+}
+
+enum sg_status
+sg_terrain_tile_vertices(
+	struct sg_terrain_tile_info const* tile,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_vertex_streams streams;
+	enum sg_status status;
+	size_t quads;
+
+	if (tile == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	status = sg_terrain_tile_check(tile, &quads);
+	if (!sg_success(status))
+		return status;
+
+	if (positions == NULL && normals == NULL && texcoords == NULL) {
+		*length = (quads + 1) * (quads + 1);
+		if (tile->skirt_depth != 0.0f)
+			*length += 4 * (quads + 1);
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	if (tile->heightfield->heights == NULL && tile->heightfield->sample == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+
+	streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	sg_heightfield_write_window(tile->heightfield,
+	                            tile->tile_x * tile->tile_size,
+	                            tile->tile_y * tile->tile_size,
+	                            (size_t)1 << tile->lod,
+	                            quads + 1, quads + 1, &streams);
+	if (tile->stitch_edges != 0)
+		sg_terrain_tile_stitch(tile, quads, positions, normals, texcoords);
+	if (tile->skirt_depth != 0.0f)
+		sg_terrain_tile_write_skirts(tile, quads, positions, normals, texcoords, &streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_terrain_tile_indices(
+	struct sg_terrain_tile_info const* tile,
+	size_t* length,
+	SG_indice* indices
+)
+{
+	enum sg_status status;
+	size_t quads;
+	size_t side;
+	size_t tile_length;
+	size_t n = 0;
+
+	if (tile == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	status = sg_terrain_tile_check(tile, &quads);
+	if (!sg_success(status))
+		return status;
+	side = quads + 1;
+
+	// Every vertex of the tile, skirts included, must be an SG_indice.
+	tile_length = side * side + ((tile->skirt_depth != 0.0f) ? 4 * side : 0);
+	if (tile_length - 1 > (size_t)SG_INDICE_MAX)
+		return SG_ERR_INVALID_RANGE;
+
+	if (indices == NULL) {
+		*length = quads * quads * 6;
+		if (tile->skirt_depth != 0.0f)
+			*length += 4 * quads * 6;
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	for (size_t j = 0; j < quads; j++) {
+		for (size_t i = 0; i < quads; i++) {
+			const SG_indice a = (SG_indice)(j * side + i);
+			const SG_indice b = a + 1;
+			const SG_indice c = (SG_indice)(a + side);
+			const SG_indice e = c + 1;
+
+			indices[n++] = a;
+			indices[n++] = b;
+			indices[n++] = e;
+
+			indices[n++] = a;
+			indices[n++] = e;
+			indices[n++] = c;
+		}
+	}
+
+	if (tile->skirt_depth == 0.0f)
+		return SG_OK_RETURNED_BUFFER;
+
+	for (size_t edge = 0; edge < 4; edge++) {
+		// The walls of the south & east edges face outwards as is,
+		// the ones of the north & west edges are flipped.
+		const int flipped = (edge == 1 || edge == 2);
+		for (size_t k = 0; k < quads; k++) {
+			const SG_indice a = (SG_indice)((edge == 0) ? k
+				: (edge == 1) ? quads * side + k
+				: (edge == 2) ? k * side
+				: k * side + quads);
+			const SG_indice b = (SG_indice)((edge < 2) ? a + 1 : a + side);
+			const SG_indice skirt_a = (SG_indice)(side * side + edge * side + k);
+			const SG_indice skirt_b = skirt_a + 1;
+
+			if (flipped) {
+				indices[n++] = skirt_a;
+				indices[n++] = b;
+				indices[n++] = skirt_b;
+
+				indices[n++] = skirt_a;
+				indices[n++] = a;
+				indices[n++] = b;
+			} else {
+				indices[n++] = skirt_a;
+				indices[n++] = skirt_b;
+				indices[n++] = b;
+
+				indices[n++] = skirt_a;
+				indices[n++] = b;
+				indices[n++] = a;
+			}
+		}
+	}
+	return SG_OK_RETURNED_BUFFER;
+}
+
+
+#if 0
+	const struct sg_normal _normals[36] = {
+		{0.0f,  0.0f, -1.0f}, {0.0f,  0.0f, -1.0f},  {0.0f,  0.0f, -1.0f}, 
+		{0.0f,  0.0f, -1.0f}, {0.0f,  0.0f, -1.0f},  {0.0f,  0.0f, -1.0f}, 
+
+		{0.0f,  0.0f, 1.0f}, {0.0f,  0.0f, 1.0f}, {0.0f,  0.0f, 1.0f},
+		{0.0f,  0.0f, 1.0f}, {0.0f,  0.0f, 1.0f}, {0.0f,  0.0f, 1.0f},
+
+		{1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f},
+		{1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f},
+
+		{1.0f,  0.0f,  0.0f},{1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f},
+		{1.0f,  0.0f,  0.0f},{1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f},
+
+		{0.0f, -1.0f,  0.0f}, {0.0f, -1.0f,  0.0f}, {0.0f, -1.0f,  0.0f},
+		{0.0f, -1.0f,  0.0f}, {0.0f, -1.0f,  0.0f}, {0.0f, -1.0f,  0.0f},
+
+		{0.0f,  1.0f,  0.0f}, {0.0f,  1.0f,  0.0f}, {0.0f,  1.0f,  0.0f},
+		{0.0f,  1.0f,  0.0f}, {0.0f,  1.0f,  0.0f}, {0.0f,  1.0f,  0.0f}
+	};
+#endif
+
+static const struct sg_normal sg_cube_normals[36] = {
+	{-1.0f,  0.0f,  0.0f},
+	{-1.0f,  0.0f,  0.0f},
+	{-1.0f,  0.0f,  0.0f},
+	{-1.0f,  0.0f,  0.0f},
+	{-1.0f,  0.0f,  0.0f},
+	{-1.0f,  0.0f,  0.0f},
+
+	{0.0f,  0.0f, -1.0f},
+	{0.0f,  0.0f, -1.0f},
+	{0.0f,  0.0f, -1.0f},
+	{0.0f,  0.0f, -1.0f},
+	{0.0f,  0.0f, -1.0f},
+	{0.0f,  0.0f, -1.0f},
+
+	{0.0f, -1.0f,  0.0f},
+	{0.0f, -1.0f,  0.0f},
+	{0.0f, -1.0f,  0.0f},
+	{0.0f, -1.0f,  0.0f},
+	{0.0f, -1.0f,  0.0f},
+	{0.0f, -1.0f,  0.0f},
+	
+	{0.0f,  1.0f,  0.0f},
+	{0.0f,  1.0f,  0.0f},
+	{0.0f,  1.0f,  0.0f},
+	{0.0f,  1.0f,  0.0f},
+	{0.0f,  1.0f,  0.0f},
+	{0.0f,  1.0f,  0.0f},
+	
+	{1.0f,  0.0f,  0.0f},
+	{1.0f,  0.0f,  0.0f},
+	{1.0f,  0.0f,  0.0f},
+	{1.0f,  0.0f,  0.0f},
+	{1.0f,  0.0f,  0.0f},
+	{1.0f,  0.0f,  0.0f},
+	
+	{0.0f,  0.0f,  1.0f},
+	{0.0f,  0.0f,  1.0f},
+	{0.0f,  0.0f,  1.0f},
+	{0.0f,  0.0f,  1.0f},
+	{0.0f,  0.0f,  1.0f},
+	{0.0f,  0.0f,  1.0f}
+};
+
+// Positions of a cube with unit extents, scaled by the cube info.
+//https://github.com/KhronosGroup/Vulkan-Tools/blob/main/cube/cube.cpp
+static const struct sg_position sg_cube_unit_positions[36] = {
+	{-1.0f, -1.0f, -1.0f},  // -X side
+	{-1.0f, -1.0f,  1.0f},
+	{-1.0f,  1.0f,  1.0f},
+	{-1.0f,  1.0f,  1.0f},
+	{-1.0f,  1.0f, -1.0f},
+	{-1.0f, -1.0f, -1.0f},
+	{-1.0f, -1.0f, -1.0f},  // -Z side
+	{ 1.0f,  1.0f, -1.0f},
+	{ 1.0f, -1.0f, -1.0f},
+	{-1.0f, -1.0f, -1.0f},
+	{-1.0f,  1.0f, -1.0f},
+	{ 1.0f,  1.0f, -1.0f},
+	{-1.0f, -1.0f, -1.0f},  // -Y side
+	{ 1.0f, -1.0f, -1.0f},
+	{ 1.0f, -1.0f,  1.0f},
+	{-1.0f, -1.0f, -1.0f},
+	{ 1.0f, -1.0f,  1.0f},
+	{-1.0f, -1.0f,  1.0f},
+	{-1.0f,  1.0f, -1.0f},  // +Y side
+	{-1.0f,  1.0f,  1.0f},
+	{ 1.0f,  1.0f,  1.0f},
+	{-1.0f,  1.0f, -1.0f},
+	{ 1.0f,  1.0f,  1.0f},
+	{ 1.0f,  1.0f, -1.0f},
+	{ 1.0f,  1.0f, -1.0f},  // +X side
+	{ 1.0f,  1.0f,  1.0f},
+	{ 1.0f, -1.0f,  1.0f},
+	{ 1.0f, -1.0f,  1.0f},
+	{ 1.0f, -1.0f, -1.0f},
+	{ 1.0f,  1.0f, -1.0f},
+	{-1.0f,  1.0f,  1.0f},  // +Z side
+	{-1.0f, -1.0f,  1.0f},
+	{ 1.0f,  1.0f,  1.0f},
+	{-1.0f, -1.0f,  1.0f},
+	{ 1.0f, -1.0f,  1.0f},
+	{ 1.0f,  1.0f,  1.0f}
+};
+
+static const struct sg_texcoord sg_cube_texcoords[36] = {
+	{0.0f, 1.0f},  // -X side
+	{1.0f, 1.0f},
+	{1.0f, 0.0f},
+	{1.0f, 0.0f},
+	{0.0f, 0.0f},
+	{0.0f, 1.0f},
+
+	{1.0f, 1.0f},  // -Z side
+	{0.0f, 0.0f},
+	{0.0f, 1.0f},
+	{1.0f, 1.0f},
+	{1.0f, 0.0f},
+	{0.0f, 0.0f},
+
+	{1.0f, 0.0f},  // -Y side
+	{1.0f, 1.0f},
+	{0.0f, 1.0f},
+	{1.0f, 0.0f},
+	{0.0f, 1.0f},
+	{0.0f, 0.0f},
+
+	{1.0f, 0.0f},  // +Y side
+	{0.0f, 0.0f},
+	{0.0f, 1.0f},
+	{1.0f, 0.0f},
+	{0.0f, 1.0f},
+	{1.0f, 1.0f},
+
+	{1.0f, 0.0f},  // +X side
+	{0.0f, 0.0f},
+	{0.0f, 1.0f},
+	{0.0f, 1.0f},
+	{1.0f, 1.0f},
+	{1.0f, 0.0f},
+
+	{0.0f, 0.0f},  // +Z side
+	{0.0f, 1.0f},
+	{1.0f, 0.0f},
+	{0.0f, 1.0f},
+	{1.0f, 1.0f},
+	{1.0f, 0.0f}
+};
+
+static void
+sg_cube_write(
+	struct sg_cube_info* info,
+	struct sg_vertex_streams const* streams
+)
+{
+	size_t i;
+	
+	// Tightly packed float streams take the tables as is.
+	if (streams->normal.format == SG_VERTEX_FORMAT_FLOAT32
+	    && streams->normal.stride == sizeof(struct sg_normal))
+		sg_memcpy_unchecked((const unsigned char*)sg_cube_normals, sizeof(sg_cube_normals), streams->normal.ptr);
+	else if (streams->normal.format != SG_VERTEX_FORMAT_NONE)
+		for (i = 0; i < 36; ++i)
+			sg_store_normal(streams, i, sg_cube_normals[i]);
+
+	if (streams->position.format == SG_VERTEX_FORMAT_FLOAT32
+	    && streams->position.stride == sizeof(struct sg_position)) {
+		struct sg_position* positions = (struct sg_position*)streams->position.ptr;
+		for (i = 0; i < 36; ++i) {
+			positions[i].x = sg_cube_unit_positions[i].x * info->width;
+			positions[i].y = sg_cube_unit_positions[i].y * info->height;
+			positions[i].z = sg_cube_unit_positions[i].z * info->depth;
+		}
+	} else if (streams->position.format != SG_VERTEX_FORMAT_NONE) {
+		for (i = 0; i < 36; ++i) {
+			const struct sg_position position{
+				.x = sg_cube_unit_positions[i].x * info->width,
+				.y = sg_cube_unit_positions[i].y * info->height,
+				.z = sg_cube_unit_positions[i].z * info->depth
+			};
+			sg_store_position(streams, i, position);
+		}
+	}
+
+	if (streams->texcoord.format == SG_VERTEX_FORMAT_FLOAT32
+	    && streams->texcoord.stride == sizeof(struct sg_texcoord))
+		sg_memcpy_unchecked((const unsigned char*)sg_cube_texcoords, sizeof(sg_cube_texcoords), streams->texcoord.ptr);
+	else if (streams->texcoord.format != SG_VERTEX_FORMAT_NONE)
+		for (i = 0; i < 36; ++i)
+			sg_store_texcoord(streams, i, sg_cube_texcoords[i]);
+}
+
+static enum sg_status
+sg_cube_streams(
+	struct sg_cube_info* info,
+	size_t* length,
+	struct sg_vertex_streams const* streams
+)
+{
+	if (info == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	if (streams == NULL) {
+		*length = 36;
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	sg_cube_write(info, streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_cube_vertices(
+	struct sg_cube_info* cube,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_vertex_streams streams;
+
+	if (positions == NULL && normals == NULL && texcoords == NULL)
+		return sg_cube_streams(cube, length, NULL);
+
+	streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	return sg_cube_streams(cube, length, &streams);
+}
+
+enum sg_status
+sg_cube_vertices_layout(
+	struct sg_cube_info* cube,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+)
+{
+	struct sg_vertex_streams streams;
+	enum sg_status status;
+
+	if (layout == NULL || layout->buffer == NULL)
+		return sg_cube_streams(cube, length, NULL);
+
+	status = sg_vertex_streams_from_layout(layout, &streams);
+	if (!sg_success(status))
+		return status;
+	return sg_cube_streams(cube, length, &streams);
+}
+
+enum sg_status
+sg_cube_generate(
+	struct sg_cube_info* cube,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+)
+{
+	struct sg_vertex_streams streams;
+	size_t vertices_length;
+	size_t indices_length = 0;
+	enum sg_status status;
+
+	status = sg_generate_check(attributes, allocator, mesh);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_cube_streams(cube, &vertices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_mesh_allocate(allocator, attributes, vertices_length, indices_length, mesh);
+	if (!sg_success(status))
+		return status;
+
+	streams = sg_vertex_streams_from_arrays(mesh->positions, mesh->normals, mesh->texcoords);
+	sg_cube_write(cube, &streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+/* Faces of the indexed cube in the order of sg_cube_write(). Vertex (i, j)
+ * of a face lies at 'origin + s * u + t * v' with texcoord (s, t), where
+ * s = i / subdivisions and t = j / subdivisions, in units of the extents.
+ * Faces where u x v points inwards have their triangles flipped.
+ */
+static const struct sg_indexed_cube_face {
+	struct sg_normal normal;
+	struct sg_position origin;
+	struct sg_position u;
+	struct sg_position v;
+	int flipped;
+} sg_indexed_cube_faces[6] = {
+	{{-1.0f,  0.0f,  0.0f}, {-1.0f,  1.0f, -1.0f}, { 0.0f,  0.0f,  2.0f}, {0.0f, -2.0f, 0.0f}, 1}, // -X side
+	{{ 0.0f,  0.0f, -1.0f}, { 1.0f,  1.0f, -1.0f}, {-2.0f,  0.0f,  0.0f}, {0.0f, -2.0f, 0.0f}, 1}, // -Z side
+	{{ 0.0f, -1.0f,  0.0f}, {-1.0f, -1.0f,  1.0f}, { 0.0f,  0.0f, -2.0f}, {2.0f,  0.0f, 0.0f}, 0}, // -Y side
+	{{ 0.0f,  1.0f,  0.0f}, {-1.0f,  1.0f,  1.0f}, { 0.0f,  0.0f, -2.0f}, {2.0f,  0.0f, 0.0f}, 1}, // +Y side
+	{{ 1.0f,  0.0f,  0.0f}, { 1.0f,  1.0f,  1.0f}, { 0.0f,  0.0f, -2.0f}, {0.0f, -2.0f, 0.0f}, 1}, // +X side
+	{{ 0.0f,  0.0f,  1.0f}, {-1.0f,  1.0f,  1.0f}, { 2.0f,  0.0f,  0.0f}, {0.0f, -2.0f, 0.0f}, 1}, // +Z side
+};
+
+static void
+sg_indexed_cube_write(
+	struct sg_indexed_cube_info const* info,
+	struct sg_vertex_streams const* streams
+)
+{
+	const size_t subdivisions = (info->subdivisions > 0) ? info->subdivisions : 1;
+	const size_t side = subdivisions + 1;
+	const float step = 1.0f / subdivisions;
+	size_t n = 0;
+
+	for (size_t f = 0; f < 6; f++) {
+		struct sg_indexed_cube_face const* face = &sg_indexed_cube_faces[f];
+		for (size_t j = 0; j < side; j++) {
+			// The last row & column land exactly on the face edges.
+			const float t = (j == subdivisions) ? 1.0f : step * j;
+			for (size_t i = 0; i < side; i++, n++) {
+				const float s = (i == subdivisions) ? 1.0f : step * i;
+				const struct sg_position position{
+					.x = info->width * (face->origin.x + s * face->u.x + t * face->v.x),
+					.y = info->height * (face->origin.y + s * face->u.y + t * face->v.y),
+					.z = info->depth * (face->origin.z + s * face->u.z + t * face->v.z)
+				};
+				const struct sg_texcoord texcoord{
+					.u = s,
+					.v = t
+				};
+				sg_store_position(streams, n, position);
+				sg_store_normal(streams, n, face->normal);
+				sg_store_texcoord(streams, n, texcoord);
+			}
+		}
+	}
+}
+
+static enum sg_status
+sg_indexed_cube_streams(
+	struct sg_indexed_cube_info const* info,
+	size_t* length,
+	struct sg_vertex_streams const* streams
+)
+{
+	size_t subdivisions;
+
+	if (info == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	if (streams == NULL) {
+		subdivisions = (info->subdivisions > 0) ? info->subdivisions : 1;
+		*length = 6 * (subdivisions + 1) * (subdivisions + 1);
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	sg_indexed_cube_write(info, streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_cube_vertices(
+	struct sg_indexed_cube_info const* cube,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_vertex_streams streams;
+
+	if (positions == NULL && normals == NULL && texcoords == NULL)
+		return sg_indexed_cube_streams(cube, length, NULL);
+
+	streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	return sg_indexed_cube_streams(cube, length, &streams);
+}
+
+enum sg_status
+sg_indexed_cube_vertices_layout(
+	struct sg_indexed_cube_info const* cube,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+)
+{
+	struct sg_vertex_streams streams;
+	enum sg_status status;
+
+	if (layout == NULL || layout->buffer == NULL)
+		return sg_indexed_cube_streams(cube, length, NULL);
+
+	status = sg_vertex_streams_from_layout(layout, &streams);
+	if (!sg_success(status))
+		return status;
+	return sg_indexed_cube_streams(cube, length, &streams);
+}
+
+enum sg_status
+sg_indexed_cube_indices(
+	struct sg_indexed_cube_info const* cube,
+	size_t* length,
+	SG_indice* indices
+)
+{
+	size_t subdivisions;
+	size_t side;
+	size_t n = 0;
+
+	if (cube == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	subdivisions = (cube->subdivisions > 0) ? cube->subdivisions : 1;
+	side = subdivisions + 1;
+
+	// Faces are 6 grids of side * side vertices, one after the other.
+	if (!sg_indices_fit_grid(side * side, 6))
+		return SG_ERR_INVALID_RANGE;
+
+	if (indices == NULL) {
+		*length = 6 * subdivisions * subdivisions * 6;
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	for (size_t f = 0; f < 6; f++) {
+		const size_t first = f * side * side;
+		const int flipped = sg_indexed_cube_faces[f].flipped;
+		for (size_t j = 0; j < subdivisions; j++) {
+			for (size_t i = 0; i < subdivisions; i++) {
+				const SG_indice a = (SG_indice)(first + j * side + i);
+				const SG_indice b = a + 1;
+				const SG_indice c = (SG_indice)(a + side);
+				const SG_indice e = c + 1;
+
+				indices[n++] = a;
+				indices[n++] = flipped ? e : b;
+				indices[n++] = flipped ? b : e;
+
+				indices[n++] = a;
+				indices[n++] = flipped ? c : e;
+				indices[n++] = flipped ? e : c;
+			}
+		}
+	}
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_cube_generate(
+	struct sg_indexed_cube_info const* cube,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+)
+{
+	struct sg_vertex_streams streams;
+	size_t vertices_length;
+	size_t indices_length = 0;
+	enum sg_status status;
+
+	status = sg_generate_check(attributes, allocator, mesh);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_indexed_cube_streams(cube, &vertices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_indexed_cube_indices(cube, &indices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_mesh_allocate(allocator, attributes, vertices_length, indices_length, mesh);
+	if (!sg_success(status))
+		return status;
+
+	streams = sg_vertex_streams_from_arrays(mesh->positions, mesh->normals, mesh->texcoords);
+	sg_indexed_cube_write(cube, &streams);
+	sg_indexed_cube_indices(cube, &indices_length, mesh->indices);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+
+
+#define SG_SPHERE_ROW_TILE 64
+
+/* Scale the slice tables of a row by sin(phi) and the radius, 8 or 4
+ * vertices per iteration when SIMD is available. Only multiplies are used,
+ * so every path produces the same bits as the scalar tail.
+ */
+static inline void
+sg_indexed_sphere_row_kernel(
+	const float* slice_cos,
+	const float* slice_sin,
+	const size_t count,
+	const float sin_phi,
+	const float radius,
+	float* normals_x,
+	float* normals_z,
+	float* positions_x,
+	float* positions_z
+)
+{
+	size_t j = 0;
+
+#if defined(SG_SIMD_AVX2)
+	{
+		const __m256 s8 = _mm256_set1_ps(sin_phi);
+		const __m256 r8 = _mm256_set1_ps(radius);
+		for (; j + 8 <= count; j += 8) {
+			const __m256 nx = _mm256_mul_ps(_mm256_loadu_ps(slice_cos + j), s8);
+			const __m256 nz = _mm256_mul_ps(_mm256_loadu_ps(slice_sin + j), s8);
+			_mm256_storeu_ps(normals_x + j, nx);
+			_mm256_storeu_ps(normals_z + j, nz);
+			_mm256_storeu_ps(positions_x + j, _mm256_mul_ps(nx, r8));
+			_mm256_storeu_ps(positions_z + j, _mm256_mul_ps(nz, r8));
+		}
+	}
+#endif
+#if defined(SG_SIMD_SSE2)
+	{
+		const __m128 s4 = _mm_set1_ps(sin_phi);
+		const __m128 r4 = _mm_set1_ps(radius);
+		for (; j + 4 <= count; j += 4) {
+			const __m128 nx = _mm_mul_ps(_mm_loadu_ps(slice_cos + j), s4);
+			const __m128 nz = _mm_mul_ps(_mm_loadu_ps(slice_sin + j), s4);
+			_mm_storeu_ps(normals_x + j, nx);
+			_mm_storeu_ps(normals_z + j, nz);
+			_mm_storeu_ps(positions_x + j, _mm_mul_ps(nx, r4));
+			_mm_storeu_ps(positions_z + j, _mm_mul_ps(nz, r4));
+		}
+	}
+#elif defined(SG_SIMD_NEON)
+	{
+		const float32x4_t s4 = vdupq_n_f32(sin_phi);
+		const float32x4_t r4 = vdupq_n_f32(radius);
+		for (; j + 4 <= count; j += 4) {
+			const float32x4_t nx = vmulq_f32(vld1q_f32(slice_cos + j), s4);
+			const float32x4_t nz = vmulq_f32(vld1q_f32(slice_sin + j), s4);
+			vst1q_f32(normals_x + j, nx);
+			vst1q_f32(normals_z + j, nz);
+			vst1q_f32(positions_x + j, vmulq_f32(nx, r4));
+			vst1q_f32(positions_z + j, vmulq_f32(nz, r4));
+		}
+	}
+#endif
+
+	for (; j < count; j++) {
+		normals_x[j] = slice_cos[j] * sin_phi;
+		normals_z[j] = slice_sin[j] * sin_phi;
+		positions_x[j] = normals_x[j] * radius;
+		positions_z[j] = normals_z[j] * radius;
+	}
+}
+
+static void
+sg_indexed_sphere_write_rows(
+	struct sg_indexed_sphere_info* info,
+	const size_t first_stack,
+	const size_t last_stack,
+	struct sg_vertex_streams const* streams
+)
+/**
+ * Original Reference:
+ * https://www.3dgep.com/texturing-and-lighting-with-opengl-and-glsl/#Creating_a_Sphere
+ *
+ * Trig is evaluated once per slice and once per stack, vertices are built
+ * from multiplies only. Compared to evaluating every vertex on its own,
+ * slices are sampled at j * (2pi / slices) instead of (j / slices) * 2pi
+ * and the seam column is an exact copy of the first one. Every vertex of a
+ * unit sphere stays within 5e-7 of the exact sphere (test/validation/sphere.cpp).
+ */
+{
+	const size_t stacks = info->stacks;
+	const size_t slices = info->slices;
+	const size_t row_length = slices + 1;
+	const size_t span_capacity = SG_RING_TABLE_CAPACITY + 1;
+	const float radius = info->radius;
+	const float slice_step = 2 * SG_PI / slices;
+
+	float slice_cos[SG_RING_TABLE_CAPACITY + 1];
+	float slice_sin[SG_RING_TABLE_CAPACITY + 1];
+	float slice_u[SG_RING_TABLE_CAPACITY + 1];
+
+	// Rows are computed into small tiles before being stored, keeping the
+	// writes to the different streams close together.
+	float normals_x[SG_SPHERE_ROW_TILE];
+	float normals_z[SG_SPHERE_ROW_TILE];
+	float positions_x[SG_SPHERE_ROW_TILE];
+	float positions_z[SG_SPHERE_ROW_TILE];
+
+	// Columns are generated in spans fitting the slice tables.
+	for (size_t first = 0; first < row_length; first += span_capacity) {
+		const size_t span = (row_length - first < span_capacity)
+			? row_length - first
+			: span_capacity;
+
+		for (size_t j = 0; j < span; j++) {
+			sg_ring_sample(slices, slice_step, first + j, &slice_cos[j], &slice_sin[j]);
+			slice_u[j] = (first + j) / (float)slices;
+		}
+
+		for (size_t i = first_stack; i < last_stack; ++i) {
+			const float v = i / (float)stacks;
+			const float phi = v * SG_PI;
+			const float sin_phi = SG_SIN(phi);
+			const float cos_phi = SG_COS(phi);
+			const float position_y = cos_phi * radius;
+
+			for (size_t j = 0; j < span; j += SG_SPHERE_ROW_TILE) {
+				const size_t n = i * row_length + first + j;
+				const size_t count = (span - j < SG_SPHERE_ROW_TILE)
+					? span - j
+					: SG_SPHERE_ROW_TILE;
+
+				sg_indexed_sphere_row_kernel(slice_cos + j, slice_sin + j, count,
+				                             sin_phi, radius,
+				                             normals_x, normals_z,
+				                             positions_x, positions_z);
+
+				sg_vertex_stream_store_row3(&streams->normal, n,
+				                            normals_x, cos_phi, normals_z, count);
+				sg_vertex_stream_store_row3(&streams->position, n,
+				                            positions_x, position_y, positions_z, count);
+				sg_vertex_stream_store_row2(&streams->texcoord, n,
+				                            slice_u + j, v, count);
+			}
+		}
+	}
+}
+
+static void
+sg_indexed_sphere_write(
+	struct sg_indexed_sphere_info* info,
+	struct sg_vertex_streams const* streams
+)
+{
+	sg_indexed_sphere_write_rows(info, 0, info->stacks + 1, streams);
+}
+
+static enum sg_status
+sg_indexed_sphere_streams(
+	struct sg_indexed_sphere_info* info,
+	size_t* length,
+	struct sg_vertex_streams const* streams
+)
+{
+	if (info == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	if (streams == NULL) {
+		*length = (info->slices+1)*(info->stacks+1);
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	sg_indexed_sphere_write(info, streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_sphere_vertices(
+	struct sg_indexed_sphere_info* sphere,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_vertex_streams streams;
+
+	if (positions == NULL && normals == NULL && texcoords == NULL)
+		return sg_indexed_sphere_streams(sphere, length, NULL);
+
+	streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	return sg_indexed_sphere_streams(sphere, length, &streams);
+}
+
+enum sg_status
+sg_indexed_sphere_vertices_layout(
+	struct sg_indexed_sphere_info* sphere,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+)
+{
+	struct sg_vertex_streams streams;
+	enum sg_status status;
+
+	if (layout == NULL || layout->buffer == NULL)
+		return sg_indexed_sphere_streams(sphere, length, NULL);
+
+	status = sg_vertex_streams_from_layout(layout, &streams);
+	if (!sg_success(status))
+		return status;
+	return sg_indexed_sphere_streams(sphere, length, &streams);
+}
+
+static void
+sg_indexed_sphere_write_index_rows(
+	struct sg_indexed_sphere_info* info,
+	const size_t first_stack,
+	const size_t last_stack,
+	SG_indice* indices
+)
+{
+	const size_t slices = info->slices;
+	const size_t row_length = slices + 1;
+	size_t n = first_stack * slices * 6;
+	for (size_t i = first_stack; i < last_stack; ++i) {
+		for (size_t j = 0; j < slices; ++j) {
+			const size_t top = i * row_length + j;
+			const size_t bottom = top + row_length;
+
+			indices[n++] = top;
+			indices[n++] = bottom + 1;
+			indices[n++] = bottom;
+
+			indices[n++] = bottom + 1;
+			indices[n++] = top;
+			indices[n++] = top + 1;
+		}
+	}
+}
+
+static void
+sg_indexed_sphere_write_indices(
+	struct sg_indexed_sphere_info* info,
+	SG_indice* indices
+)
+{
+	sg_indexed_sphere_write_index_rows(info, 0, info->stacks, indices);
+}
+
+enum sg_status
+sg_indexed_sphere_indices(
+	struct sg_indexed_sphere_info* info,
+	size_t* length,
+	SG_indice* indices
+)
+{
+	if (info == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	if (!sg_indices_fit_grid(info->slices + 1, info->stacks + 1))
+		return SG_ERR_INVALID_RANGE;
+	
+	if (indices == NULL) {
+		*length = info->slices * info->stacks * 6;
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	sg_indexed_sphere_write_indices(info, indices);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_sphere_generate(
+	struct sg_indexed_sphere_info* sphere,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+)
+{
+	struct sg_vertex_streams streams;
+	size_t vertices_length;
+	size_t indices_length = 0;
+	enum sg_status status;
+
+	status = sg_generate_check(attributes, allocator, mesh);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_indexed_sphere_streams(sphere, &vertices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_indexed_sphere_indices(sphere, &indices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_mesh_allocate(allocator, attributes, vertices_length, indices_length, mesh);
+	if (!sg_success(status))
+		return status;
+
+	streams = sg_vertex_streams_from_arrays(mesh->positions, mesh->normals, mesh->texcoords);
+	sg_indexed_sphere_write(sphere, &streams);
+	sg_indexed_sphere_write_indices(sphere, mesh->indices);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_sphere_vertices_range(
+	struct sg_indexed_sphere_info* sphere,
+	const size_t first_stack,
+	const size_t last_stack,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_vertex_streams streams;
+
+	if (sphere == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	if (positions == NULL && normals == NULL && texcoords == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (first_stack >= last_stack || last_stack > sphere->stacks + 1)
+		return SG_ERR_INVALID_RANGE;
+
+	streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	sg_indexed_sphere_write_rows(sphere, first_stack, last_stack, &streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_sphere_indices_range(
+	struct sg_indexed_sphere_info* sphere,
+	const size_t first_stack,
+	const size_t last_stack,
+	SG_indice* indices
+)
+{
+	if (sphere == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	if (indices == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (!sg_indices_fit_grid(sphere->slices + 1, sphere->stacks + 1))
+		return SG_ERR_INVALID_RANGE;
+	if (first_stack >= last_stack || last_stack > sphere->stacks)
+		return SG_ERR_INVALID_RANGE;
+
+	sg_indexed_sphere_write_index_rows(sphere, first_stack, last_stack, indices);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+#ifdef SIMPLE_GEOMETRY_USE_PTHREADS
+#ifndef SG_MAX_THREADS
+#define SG_MAX_THREADS 64
+#endif
+
+struct sg_parallel_rows {
+	void (*run)(void* context, size_t first_row, size_t last_row);
+	void* context;
+	size_t first_row;
+	size_t last_row;
+};
+
+static void*
+sg_parallel_rows_main(void* arg)
+{
+	struct sg_parallel_rows* rows = (struct sg_parallel_rows*)arg;
+	rows->run(rows->context, rows->first_row, rows->last_row);
+	return NULL;
+}
+
+/* Split rows into contiguous ranges, one per thread. The calling thread
+ * takes the first range, and ranges whose thread could not be created are
+ * run inline after it, so the result never depends on thread creation.
+ */
+static void
+sg_parallel_for_rows(
+	const size_t row_count,
+	size_t thread_count,
+	void (*run)(void* context, size_t first_row, size_t last_row),
+	void* context
+)
+{
+	struct sg_parallel_rows ranges[SG_MAX_THREADS];
+	pthread_t threads[SG_MAX_THREADS];
+	int started[SG_MAX_THREADS];
+
+	if (thread_count > SG_MAX_THREADS)
+		thread_count = SG_MAX_THREADS;
+	if (thread_count > row_count)
+		thread_count = row_count;
+	if (thread_count < 1)
+		thread_count = 1;
+
+	for (size_t t = 0; t < thread_count; t++) {
+		ranges[t].run = run;
+		ranges[t].context = context;
+		ranges[t].first_row = row_count * t / thread_count;
+		ranges[t].last_row = row_count * (t + 1) / thread_count;
+		started[t] = 0;
+	}
+
+	for (size_t t = 1; t < thread_count; t++)
+		started[t] = pthread_create(&threads[t], NULL, sg_parallel_rows_main, &ranges[t]) == 0;
+
+	sg_parallel_rows_main(&ranges[0]);
+
+	for (size_t t = 1; t < thread_count; t++) {
+		if (started[t])
+			pthread_join(threads[t], NULL);
+		else
+			sg_parallel_rows_main(&ranges[t]);
+	}
+}
+
+struct sg_indexed_sphere_parallel_context {
+	struct sg_indexed_sphere_info* sphere;
+	struct sg_vertex_streams streams;
+	SG_indice* indices;
+};
+
+static void
+sg_indexed_sphere_vertices_rows_job(void* context, size_t first_row, size_t last_row)
+{
+	struct sg_indexed_sphere_parallel_context* job =
+		(struct sg_indexed_sphere_parallel_context*)context;
+	sg_indexed_sphere_write_rows(job->sphere, first_row, last_row, &job->streams);
+}
+
+static void
+sg_indexed_sphere_indices_rows_job(void* context, size_t first_row, size_t last_row)
+{
+	struct sg_indexed_sphere_parallel_context* job =
+		(struct sg_indexed_sphere_parallel_context*)context;
+	sg_indexed_sphere_write_index_rows(job->sphere, first_row, last_row, job->indices);
+}
+
+enum sg_status
+sg_indexed_sphere_vertices_parallel(
+	struct sg_indexed_sphere_info* sphere,
+	const size_t thread_count,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_indexed_sphere_parallel_context job;
+	enum sg_status status;
+
+	status = sg_indexed_sphere_streams(sphere, length, NULL);
+	if (!sg_success(status))
+		return status;
+	if (positions == NULL && normals == NULL && texcoords == NULL)
+		return status;
+
+	job.sphere = sphere;
+	job.streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	job.indices = NULL;
+	sg_parallel_for_rows(sphere->stacks + 1, thread_count,
+	                     sg_indexed_sphere_vertices_rows_job, &job);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_sphere_indices_parallel(
+	struct sg_indexed_sphere_info* sphere,
+	const size_t thread_count,
+	size_t* length,
+	SG_indice* indices
+)
+{
+	struct sg_indexed_sphere_parallel_context job;
+	enum sg_status status;
+
+	status = sg_indexed_sphere_indices(sphere, length, NULL);
+	if (!sg_success(status))
+		return status;
+	if (indices == NULL)
+		return status;
+
+	job.sphere = sphere;
+	job.indices = indices;
+	sg_parallel_for_rows(sphere->stacks, thread_count,
+	                     sg_indexed_sphere_indices_rows_job, &job);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+struct sg_indexed_plane_parallel_context {
+	struct sg_indexed_plane_info const* plane;
+	struct sg_vertex_streams streams;
+	SG_indice* indices;
+};
+
+static void
+sg_indexed_plane_vertices_rows_job(void* context, size_t first_row, size_t last_row)
+{
+	struct sg_indexed_plane_parallel_context* job =
+		(struct sg_indexed_plane_parallel_context*)context;
+	sg_indexed_plane_write_rows(job->plane, first_row, last_row, &job->streams);
+}
+
+static void
+sg_indexed_plane_indices_rows_job(void* context, size_t first_row, size_t last_row)
+{
+	struct sg_indexed_plane_parallel_context* job =
+		(struct sg_indexed_plane_parallel_context*)context;
+	sg_indexed_plane_write_index_rows(job->plane, first_row, last_row, job->indices);
+}
+
+enum sg_status
+sg_indexed_plane_vertices_parallel(
+	struct sg_indexed_plane_info const* plane,
+	const size_t thread_count,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_indexed_plane_parallel_context job;
+	enum sg_status status;
+
+	status = sg_indexed_plane_streams(plane, length, NULL);
+	if (!sg_success(status))
+		return status;
+	if (positions == NULL && normals == NULL && texcoords == NULL)
+		return status;
+
+	job.plane = plane;
+	job.streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	job.indices = NULL;
+	sg_parallel_for_rows(plane->depth_subdivisions, thread_count,
+	                     sg_indexed_plane_vertices_rows_job, &job);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_plane_indices_parallel(
+	struct sg_indexed_plane_info const* plane,
+	const size_t thread_count,
+	size_t* length,
+	SG_indice* indices
+)
+{
+	struct sg_indexed_plane_parallel_context job;
+	enum sg_status status;
+
+	status = sg_indexed_plane_indices(plane, length, NULL);
+	if (!sg_success(status))
+		return status;
+	if (indices == NULL)
+		return status;
+
+	job.plane = plane;
+	job.indices = indices;
+	sg_parallel_for_rows(plane->depth_subdivisions - 1, thread_count,
+	                     sg_indexed_plane_indices_rows_job, &job);
+	return SG_OK_RETURNED_BUFFER;
+}
+#endif
+
+/* Components of the unit side normal of a cylinder, the xz part scaling
+ * the direction of a ring vertex and the y part following the taper, so
+ * the normal is (cos(a) * cos(theta), sin(a), cos(a) * sin(theta)) for a
+ * taper angle a. A flat side falls back to a radial normal.
+ */
+static inline void
+sg_cylinder_side_normal(
+	struct sg_cylinder_info const* cylinder,
+	float* normal_xz,
+	float* normal_y
+)
+{
+	const float slope = cylinder->bottom_radius - cylinder->top_radius;
+	const float length_squared = cylinder->height * cylinder->height + slope * slope;
+	float inverse_length;
+
+	if (length_squared == 0.0f) {
+		*normal_xz = 1.0f;
+		*normal_y = 0.0f;
+		return;
+	}
+	inverse_length = 1.0f / SG_SQUARE_ROOT(length_squared);
+	*normal_xz = cylinder->height * inverse_length;
+	*normal_y = slope * inverse_length;
+}
+
+/* Stacks along the side of a cylinder, 0 is treated as 1. */
+static inline size_t
+sg_cylinder_stacks(struct sg_cylinder_info const* cylinder)
+{
+	return (cylinder->stacks > 0) ? cylinder->stacks : 1;
+}
+
+/* Height, radius & texcoord v of side ring k of 'stacks', from the bottom
+ * up. The outer rings land exactly on the caps.
+ */
+static inline void
+sg_cylinder_ring(
+	struct sg_cylinder_info const* cylinder,
+	const size_t stacks,
+	const size_t k,
+	float* y,
+	float* radius,
+	float* v
+)
+{
+	const float t = (float)k / stacks;
+
+	if (k == stacks) {
+		*y = cylinder->height / 2;
+		*radius = cylinder->top_radius;
+		*v = 0.0f;
+		return;
+	}
+	*y = -(cylinder->height / 2) + cylinder->height * t;
+	*radius = cylinder->bottom_radius + (cylinder->top_radius - cylinder->bottom_radius) * t;
+	*v = 1.0f - t;
+}
+
+static void
+sg_cylinder_write(
+	struct sg_cylinder_info* cylinder,
+	struct sg_vertex_streams const* streams
+)
+{
+	
+	const float cylinder_top_radius = cylinder->top_radius;
+	const float cylinder_bottom_radius = cylinder->bottom_radius;
+	const float cylinder_height = cylinder->height;
+	const size_t cylinder_subdivisions = cylinder->subdivisions;
+	const size_t cylinder_stacks = sg_cylinder_stacks(cylinder);
+	float normal_xz;
+	float normal_y;
+	
+	const struct sg_normal bottom_cap_normal{ 0.0f, -1.0f, 0.0f };
+	const struct sg_normal top_cap_normal{ 0.0f, 1.0f, 0.0f };
+	
+	const float top_y = cylinder_height / 2;
+	const float bottom_y = -(cylinder_height / 2);
+	const int write_positions = streams->position.format != SG_VERTEX_FORMAT_NONE;
+	const int write_normals = streams->normal.format != SG_VERTEX_FORMAT_NONE;
+	const int write_texcoords = streams->texcoord.format != SG_VERTEX_FORMAT_NONE;
+	const float u_scale = 1.0f / cylinder_subdivisions;
+
+	// The bottom cap, top cap and sides are written in a single pass,
+	// each sector landing in its own region of the streams.
+	const size_t top_cap_start = cylinder_subdivisions * 3;
+	const size_t sides_start = cylinder_subdivisions * 6;
+
+	struct sg_ring_table ring;
+	sg_ring_table_init(&ring, cylinder_subdivisions);
+	sg_cylinder_side_normal(cylinder, &normal_xz, &normal_y);
+
+	float cos_angle = sg_ring_cos(&ring, 0);
+	float sin_angle = sg_ring_sin(&ring, 0);
+	for (size_t i = 0; i < cylinder_subdivisions; i++) {
+		const float next_cos_angle = sg_ring_cos(&ring, i + 1);
+		const float next_sin_angle = sg_ring_sin(&ring, i + 1);
+		const size_t bottom_count = i * 3;
+		const size_t top_count = top_cap_start + i * 3;
+
+		if (write_positions) {
+			const struct sg_position bl{
+				.x = cos_angle * cylinder_bottom_radius,
+				.y = bottom_y,
+				.z = sin_angle * cylinder_bottom_radius
+			};
+			const struct sg_position br{
+				.x = next_cos_angle * cylinder_bottom_radius,
+				.y = bottom_y,
+				.z = next_sin_angle * cylinder_bottom_radius
+			};
+			const struct sg_position tl{
+				.x = cos_angle * cylinder_top_radius,
+				.y = top_y,
+				.z = sin_angle * cylinder_top_radius
+			};
+			const struct sg_position tr{
+				.x = next_cos_angle * cylinder_top_radius,
+				.y = top_y,
+				.z = next_sin_angle * cylinder_top_radius
+			};
+
+			// Generate bottom cap
+			sg_store_position(streams, bottom_count + 0, (struct sg_position){ 0, bottom_y, 0 });
+			sg_store_position(streams, bottom_count + 1, bl);
+			sg_store_position(streams, bottom_count + 2, br);
+
+			// Generate top cap
+			sg_store_position(streams, top_count + 0, (struct sg_position){ 0, top_y, 0 });
+			sg_store_position(streams, top_count + 1, tr);
+			sg_store_position(streams, top_count + 2, tl);
+		}
+
+		if (write_normals) {
+			sg_store_normal(streams, bottom_count + 0, bottom_cap_normal);
+			sg_store_normal(streams, bottom_count + 1, bottom_cap_normal);
+			sg_store_normal(streams, bottom_count + 2, bottom_cap_normal);
+
+			sg_store_normal(streams, top_count + 0, top_cap_normal);
+			sg_store_normal(streams, top_count + 1, top_cap_normal);
+			sg_store_normal(streams, top_count + 2, top_cap_normal);
+		}
+
+		if (write_texcoords) {
+			// Planar disc texcoords on the caps.
+			const struct sg_texcoord centre{ 0.5f, 0.5f };
+			const struct sg_texcoord disc{
+				.u = 0.5f + 0.5f * cos_angle,
+				.v = 0.5f + 0.5f * sin_angle
+			};
+			const struct sg_texcoord next_disc{
+				.u = 0.5f + 0.5f * next_cos_angle,
+				.v = 0.5f + 0.5f * next_sin_angle
+			};
+
+			sg_store_texcoord(streams, bottom_count + 0, centre);
+			sg_store_texcoord(streams, bottom_count + 1, disc);
+			sg_store_texcoord(streams, bottom_count + 2, next_disc);
+
+			sg_store_texcoord(streams, top_count + 0, centre);
+			sg_store_texcoord(streams, top_count + 1, next_disc);
+			sg_store_texcoord(streams, top_count + 2, disc);
+		}
+
+		// Generate sides, stack by stack from the bottom up, reusing the
+		// trig of the sector for every stack.
+		float lower_y, lower_radius, lower_v;
+		sg_cylinder_ring(cylinder, cylinder_stacks, 0, &lower_y, &lower_radius, &lower_v);
+		for (size_t k = 0; k < cylinder_stacks; k++) {
+			const size_t side_count = sides_start + (i * cylinder_stacks + k) * 6;
+			float upper_y, upper_radius, upper_v;
+			sg_cylinder_ring(cylinder, cylinder_stacks, k + 1, &upper_y, &upper_radius, &upper_v);
+
+			if (write_positions) {
+				const struct sg_position bl{
+					.x = cos_angle * lower_radius,
+					.y = lower_y,
+					.z = sin_angle * lower_radius
+				};
+				const struct sg_position br{
+					.x = next_cos_angle * lower_radius,
+					.y = lower_y,
+					.z = next_sin_angle * lower_radius
+				};
+				const struct sg_position tl{
+					.x = cos_angle * upper_radius,
+					.y = upper_y,
+					.z = sin_angle * upper_radius
+				};
+				const struct sg_position tr{
+					.x = next_cos_angle * upper_radius,
+					.y = upper_y,
+					.z = next_sin_angle * upper_radius
+				};
+
+				sg_store_position(streams, side_count + 0, tl);
+				sg_store_position(streams, side_count + 1, br);
+				sg_store_position(streams, side_count + 2, bl);
+				sg_store_position(streams, side_count + 3, tr);
+				sg_store_position(streams, side_count + 4, br);
+				sg_store_position(streams, side_count + 5, tl);
+			}
+
+			if (write_normals) {
+				const struct sg_normal left{
+					.x = cos_angle * normal_xz,
+					.y = normal_y,
+					.z = sin_angle * normal_xz
+				};
+				const struct sg_normal right{
+					.x = next_cos_angle * normal_xz,
+					.y = normal_y,
+					.z = next_sin_angle * normal_xz
+				};
+
+				sg_store_normal(streams, side_count + 0, left);
+				sg_store_normal(streams, side_count + 1, right);
+				sg_store_normal(streams, side_count + 2, left);
+				sg_store_normal(streams, side_count + 3, right);
+				sg_store_normal(streams, side_count + 4, right);
+				sg_store_normal(streams, side_count + 5, left);
+			}
+
+			if (write_texcoords) {
+				// Cylindrical texcoords on the sides.
+				const float u = u_scale * i;
+				const float next_u = (i + 1 == cylinder_subdivisions) ? 1.0f : u_scale * (i + 1);
+				const struct sg_texcoord bl{ u, lower_v };
+				const struct sg_texcoord br{ next_u, lower_v };
+				const struct sg_texcoord tl{ u, upper_v };
+				const struct sg_texcoord tr{ next_u, upper_v };
+
+				sg_store_texcoord(streams, side_count + 0, tl);
+				sg_store_texcoord(streams, side_count + 1, br);
+				sg_store_texcoord(streams, side_count + 2, bl);
+				sg_store_texcoord(streams, side_count + 3, tr);
+				sg_store_texcoord(streams, side_count + 4, br);
+				sg_store_texcoord(streams, side_count + 5, tl);
+			}
+
+			lower_y = upper_y;
+			lower_radius = upper_radius;
+			lower_v = upper_v;
+		}
+
+		cos_angle = next_cos_angle;
+		sin_angle = next_sin_angle;
+	}
+}
+
+static enum sg_status
+sg_cylinder_streams(
+	struct sg_cylinder_info* cylinder,
+	size_t* length,
+	struct sg_vertex_streams const* streams
+)
+{
+	if (cylinder == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+	
+	if (streams == NULL) {
+		*length = cylinder->subdivisions * 6 + cylinder->subdivisions * 6 * sg_cylinder_stacks(cylinder);
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	sg_cylinder_write(cylinder, streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_cylinder_vertices(
+	struct sg_cylinder_info* cylinder,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_vertex_streams streams;
+
+	if (positions == NULL && normals == NULL && texcoords == NULL)
+		return sg_cylinder_streams(cylinder, length, NULL);
+
+	streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	return sg_cylinder_streams(cylinder, length, &streams);
+}
+
+enum sg_status
+sg_cylinder_vertices_layout(
+	struct sg_cylinder_info* cylinder,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+)
+{
+	struct sg_vertex_streams streams;
+	enum sg_status status;
+
+	if (layout == NULL || layout->buffer == NULL)
+		return sg_cylinder_streams(cylinder, length, NULL);
+
+	status = sg_vertex_streams_from_layout(layout, &streams);
+	if (!sg_success(status))
+		return status;
+	return sg_cylinder_streams(cylinder, length, &streams);
+}
+
+enum sg_status
+sg_cylinder_generate(
+	struct sg_cylinder_info* cylinder,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+)
+{
+	struct sg_vertex_streams streams;
+	size_t vertices_length;
+	size_t indices_length = 0;
+	enum sg_status status;
+
+	status = sg_generate_check(attributes, allocator, mesh);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_cylinder_streams(cylinder, &vertices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_mesh_allocate(allocator, attributes, vertices_length, indices_length, mesh);
+	if (!sg_success(status))
+		return status;
+
+	streams = sg_vertex_streams_from_arrays(mesh->positions, mesh->normals, mesh->texcoords);
+	sg_cylinder_write(cylinder, &streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+static void
+sg_indexed_cylinder_write(
+	struct sg_cylinder_info const* cylinder,
+	struct sg_vertex_streams const* streams
+)
+{
+	const size_t subdivisions = cylinder->subdivisions;
+	const size_t stacks = sg_cylinder_stacks(cylinder);
+	const float bottom_y = -(cylinder->height / 2);
+	const float top_y = cylinder->height / 2;
+	const float u_scale = 1.0f / subdivisions;
+	float normal_xz;
+	float normal_y;
+	size_t n = 0;
+
+	struct sg_ring_table ring;
+	sg_ring_table_init(&ring, subdivisions);
+	sg_cylinder_side_normal(cylinder, &normal_xz, &normal_y);
+
+	// Sides, ring by ring from the bottom up, every ring sharing the table.
+	for (size_t k = 0; k <= stacks; k++) {
+		float y, radius, v;
+		sg_cylinder_ring(cylinder, stacks, k, &y, &radius, &v);
+
+		for (size_t i = 0; i <= subdivisions; i++, n++) {
+			const float c = sg_ring_cos(&ring, i);
+			const float s = sg_ring_sin(&ring, i);
+			sg_vertex_stream_store3(&streams->position, n, c * radius, y, s * radius);
+			sg_vertex_stream_store3(&streams->normal, n, c * normal_xz, normal_y, s * normal_xz);
+			sg_vertex_stream_store2(&streams->texcoord, n,
+			                        (i == subdivisions) ? 1.0f : u_scale * i, v);
+		}
+	}
+
+	// Bottom & top caps.
+	for (size_t cap = 0; cap < 2; cap++) {
+		const float y = (cap == 0) ? bottom_y : top_y;
+		const float radius = (cap == 0) ? cylinder->bottom_radius : cylinder->top_radius;
+		const float cap_normal_y = (cap == 0) ? -1.0f : 1.0f;
+
+		sg_vertex_stream_store3(&streams->position, n, 0.0f, y, 0.0f);
+		sg_vertex_stream_store3(&streams->normal, n, 0.0f, cap_normal_y, 0.0f);
+		sg_vertex_stream_store2(&streams->texcoord, n, 0.5f, 0.5f);
+		n++;
+
+		for (size_t i = 0; i < subdivisions; i++, n++) {
+			const float c = sg_ring_cos(&ring, i);
+			const float s = sg_ring_sin(&ring, i);
+			sg_vertex_stream_store3(&streams->position, n, c * radius, y, s * radius);
+			sg_vertex_stream_store3(&streams->normal, n, 0.0f, cap_normal_y, 0.0f);
+			sg_vertex_stream_store2(&streams->texcoord, n, 0.5f + 0.5f * c, 0.5f + 0.5f * s);
+		}
+	}
+}
+
+static enum sg_status
+sg_indexed_cylinder_streams(
+	struct sg_cylinder_info const* cylinder,
+	size_t* length,
+	struct sg_vertex_streams const* streams
+)
+{
+	if (cylinder == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	if (cylinder->subdivisions < 2)
+		return SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1;
+
+	if (streams == NULL) {
+		// 'stacks + 1' side rings followed by the two caps.
+		*length = (sg_cylinder_stacks(cylinder) + 3) * (cylinder->subdivisions + 1);
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	sg_indexed_cylinder_write(cylinder, streams);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_cylinder_vertices(
+	struct sg_cylinder_info const* cylinder,
+	size_t* length,
+	struct sg_position* positions,
+	struct sg_normal* normals,
+	struct sg_texcoord* texcoords
+)
+{
+	struct sg_vertex_streams streams;
+
+	if (positions == NULL && normals == NULL && texcoords == NULL)
+		return sg_indexed_cylinder_streams(cylinder, length, NULL);
+
+	streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	return sg_indexed_cylinder_streams(cylinder, length, &streams);
+}
+
+enum sg_status
+sg_indexed_cylinder_vertices_layout(
+	struct sg_cylinder_info const* cylinder,
+	size_t* length,
+	struct sg_vertex_layout const* layout
+)
+{
+	struct sg_vertex_streams streams;
+	enum sg_status status;
+
+	if (layout == NULL || layout->buffer == NULL)
+		return sg_indexed_cylinder_streams(cylinder, length, NULL);
+
+	status = sg_vertex_streams_from_layout(layout, &streams);
+	if (!sg_success(status))
+		return status;
+	return sg_indexed_cylinder_streams(cylinder, length, &streams);
+}
+
+enum sg_status
+sg_indexed_cylinder_indices(
+	struct sg_cylinder_info const* cylinder,
+	size_t* length,
+	SG_indice* indices
+)
+{
+	size_t subdivisions;
+	size_t columns;
+	size_t rings;
+	size_t n = 0;
+
+	if (cylinder == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	if (length == NULL)
+		return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	if (cylinder->subdivisions < 2)
+		return SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1;
+
+	subdivisions = cylinder->subdivisions;
+	columns = subdivisions + 1;
+	rings = sg_cylinder_stacks(cylinder) + 1;
+
+	// The side rings are followed by the two cap rings.
+	if (!sg_indices_fit_grid(columns, rings + 2))
+		return SG_ERR_INVALID_RANGE;
+
+	if (indices == NULL) {
+		*length = (rings - 1) * subdivisions * 6 + 2 * subdivisions * 3;
+		return SG_OK_RETURNED_LENGTH;
+	}
+
+	// Sides, wound like sg_cylinder_vertices().
+	for (size_t r = 0; r + 1 < rings; r++) {
+		for (size_t i = 0; i < subdivisions; i++) {
+			const SG_indice bl = (SG_indice)(r * columns + i);
+			const SG_indice br = bl + 1;
+			const SG_indice tl = (SG_indice)(bl + columns);
+			const SG_indice tr = tl + 1;
+
+			indices[n++] = tl;
+			indices[n++] = br;
+			indices[n++] = bl;
+
+			indices[n++] = tr;
+			indices[n++] = br;
+			indices[n++] = tl;
+		}
+	}
+
+	// Caps, the top cap being wound the other way around.
+	for (size_t cap = 0; cap < 2; cap++) {
+		const size_t centre = rings * columns + cap * columns;
+		for (size_t i = 0; i < subdivisions; i++) {
+			const SG_indice a = (SG_indice)(centre + 1 + i);
+			const SG_indice b = (SG_indice)(centre + 1 + (i + 1) % subdivisions);
+
+			indices[n++] = (SG_indice)centre;
+			indices[n++] = (cap == 0) ? a : b;
+			indices[n++] = (cap == 0) ? b : a;
+		}
+	}
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_indexed_cylinder_generate(
+	struct sg_cylinder_info const* cylinder,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator,
+	struct sg_mesh* mesh
+)
+{
+	struct sg_vertex_streams streams;
+	size_t vertices_length;
+	size_t indices_length = 0;
+	enum sg_status status;
+
+	status = sg_generate_check(attributes, allocator, mesh);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_indexed_cylinder_streams(cylinder, &vertices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_indexed_cylinder_indices(cylinder, &indices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_mesh_allocate(allocator, attributes, vertices_length, indices_length, mesh);
+	if (!sg_success(status))
+		return status;
+
+	streams = sg_vertex_streams_from_arrays(mesh->positions, mesh->normals, mesh->texcoords);
+	sg_indexed_cylinder_write(cylinder, &streams);
+	sg_indexed_cylinder_indices(cylinder, &indices_length, mesh->indices);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+/* Gizmos are built from arcs of the gizmo circle and from straight lines,
+ * the sink turns them into the requested topology. Vertices & indices are
+ * only counted while their buffer is NULL.
+ */
+struct sg_gizmo_sink {
+	enum sg_gizmo_topology topology;
+	struct sg_ring_table const* ring; /// circle of the gizmo, only read when writing positions.
+	size_t subdivisions;              /// subdivisions of the gizmo circle.
+	struct sg_mat3x4 const* transform; /// transform of the written positions, NULL for none.
+	struct sg_position* positions;
+	SG_indice* indices;
+	size_t vertices_length;
+	size_t indices_length;
+};
+
+static inline int
+sg_gizmo_topology_indexed(const enum sg_gizmo_topology topology)
+{
+	return topology == SG_GIZMO_TOPOLOGY_INDEXED_LINE_LIST
+		|| topology == SG_GIZMO_TOPOLOGY_LINE_STRIP;
+}
+
+static inline void
+sg_gizmo_sink_vertex(struct sg_gizmo_sink* sink, const struct sg_position position)
+{
+	if (sink->positions != NULL)
+		sink->positions[sink->vertices_length] = position;
+	sink->vertices_length++;
+}
+
+static inline void
+sg_gizmo_sink_index(struct sg_gizmo_sink* sink, const size_t index)
+{
+	if (sink->indices != NULL)
+		sink->indices[sink->indices_length] = (SG_indice)index;
+	sink->indices_length++;
+}
+
+static inline void
+sg_gizmo_sink_segment(
+	struct sg_gizmo_sink* sink,
+	const struct sg_position a,
+	const struct sg_position b
+)
+{
+	sg_gizmo_sink_vertex(sink, a);
+	sg_gizmo_sink_vertex(sink, b);
+	if (sink->topology == SG_GIZMO_TOPOLOGY_TRIANGLES)
+		sg_gizmo_sink_vertex(sink, a);
+}
+
+static inline struct sg_position
+sg_gizmo_transform_vector(struct sg_mat3x4 const* transform, const struct sg_position v)
+{
+	const float (*m)[4] = transform->m;
+	return (struct sg_position){
+		m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+		m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+		m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z,
+	};
+}
+
+/* Transformed copy of a point of the gizmo, when writing positions. */
+static inline struct sg_position
+sg_gizmo_sink_point(struct sg_gizmo_sink const* sink, const struct sg_position p)
+{
+	if (sink->transform == NULL || sink->positions == NULL)
+		return p;
+
+	struct sg_position position = sg_gizmo_transform_vector(sink->transform, p);
+	position.x += sink->transform->m[0][3];
+	position.y += sink->transform->m[1][3];
+	position.z += sink->transform->m[2][3];
+	return position;
+}
+
+/* Point of an arc at 'sector' of the gizmo circle. */
+static inline struct sg_position
+sg_gizmo_arc_point(
+	struct sg_gizmo_sink const* sink,
+	const struct sg_position center,
+	const struct sg_position u,
+	const struct sg_position v,
+	const size_t sector
+)
+{
+	struct sg_position position = center;
+
+	if (sink->positions != NULL) {
+		const float c = sg_ring_cos(sink->ring, sector);
+		const float s = sg_ring_sin(sink->ring, sector);
+		position.x = center.x + u.x * c + v.x * s;
+		position.y = center.y + u.y * c + v.y * s;
+		position.z = center.z + u.z * c + v.z * s;
+	}
+	return position;
+}
+
+/* Arc from sector 'first' to 'last' of the circle 'center + u * cos + v * sin',
+ * a full circle being closed. Triangles of 'reversed' arcs run from the end
+ * of each line to its start. The transform applies to the circle itself, an
+ * affine transform of an ellipse being the ellipse of the transformed basis.
+ */
+static void
+sg_gizmo_sink_arc(
+	struct sg_gizmo_sink* sink,
+	const struct sg_position arc_center,
+	const struct sg_position arc_u,
+	const struct sg_position arc_v,
+	const size_t first,
+	const size_t last,
+	const int reversed
+)
+{
+	const int transformed = (sink->transform != NULL && sink->positions != NULL);
+	const struct sg_position center = sg_gizmo_sink_point(sink, arc_center);
+	const struct sg_position u = transformed ? sg_gizmo_transform_vector(sink->transform, arc_u) : arc_u;
+	const struct sg_position v = transformed ? sg_gizmo_transform_vector(sink->transform, arc_v) : arc_v;
+	const size_t segments = last - first;
+	const int closed = (segments == sink->subdivisions);
+
+	if (!sg_gizmo_topology_indexed(sink->topology)) {
+		struct sg_position position = sg_gizmo_arc_point(sink, center, u, v, first);
+		for (size_t i = first; i < last; i++) {
+			const struct sg_position next_position = sg_gizmo_arc_point(sink, center, u, v, i + 1);
+			if (reversed)
+				sg_gizmo_sink_segment(sink, next_position, position);
+			else
+				sg_gizmo_sink_segment(sink, position, next_position);
+			position = next_position;
+		}
+		return;
+	}
+
+	const size_t base = sink->vertices_length;
+	const size_t points = closed ? segments : segments + 1;
+	for (size_t i = 0; i < points; i++)
+		sg_gizmo_sink_vertex(sink, sg_gizmo_arc_point(sink, center, u, v, first + i));
+
+	if (sink->topology == SG_GIZMO_TOPOLOGY_INDEXED_LINE_LIST) {
+		for (size_t i = 0; i < segments; i++) {
+			sg_gizmo_sink_index(sink, base + i);
+			sg_gizmo_sink_index(sink, base + (i + 1) % points);
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < points; i++)
+		sg_gizmo_sink_index(sink, base + i);
+	if (closed)
+		sg_gizmo_sink_index(sink, base);
+	sg_gizmo_sink_index(sink, SG_GIZMO_STRIP_RESTART);
+}
+
+/* Straight lines between pairs of 'points', the indexed topologies share
+ * the points between lines.
+ */
+static void
+sg_gizmo_sink_lines(
+	struct sg_gizmo_sink* sink,
+	struct sg_position const* points,
+	const size_t points_length,
+	const unsigned char (*lines)[2],
+	const size_t lines_length
+)
+{
+	if (!sg_gizmo_topology_indexed(sink->topology)) {
+		for (size_t i = 0; i < lines_length; i++)
+			sg_gizmo_sink_segment(sink,
+			                      sg_gizmo_sink_point(sink, points[lines[i][0]]),
+			                      sg_gizmo_sink_point(sink, points[lines[i][1]]));
+		return;
+	}
+
+	const size_t base = sink->vertices_length;
+	for (size_t i = 0; i < points_length; i++)
+		sg_gizmo_sink_vertex(sink, sg_gizmo_sink_point(sink, points[i]));
+
+	for (size_t i = 0; i < lines_length; i++) {
+		sg_gizmo_sink_index(sink, base + lines[i][0]);
+		sg_gizmo_sink_index(sink, base + lines[i][1]);
+		if (sink->topology == SG_GIZMO_TOPOLOGY_LINE_STRIP)
+			sg_gizmo_sink_index(sink, SG_GIZMO_STRIP_RESTART);
+	}
+}
+
+/* Run a gizmo emitter to either count or write its vertices & indices. */
+static enum sg_status
+sg_gizmo_emit_transformed(
+	void (*emit)(void const* info, struct sg_gizmo_sink* sink),
+	void const* info,
+	const enum sg_gizmo_topology topology,
+	const size_t subdivisions,
+	struct sg_mat3x4 const* transform,
+	size_t* vertices_length,
+	struct sg_position* positions,
+	size_t* indices_length,
+	SG_indice* indices
+)
+{
+	struct sg_ring_table ring;
+	struct sg_gizmo_sink sink{};
+
+	if (subdivisions == 1)
+		return SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1;
+
+	sink.topology = topology;
+	sink.ring = &ring;
+	sink.subdivisions = (subdivisions > 0) ? subdivisions : SG_GIZMO_CIRCLE_SUBDIVISIONS;
+	sink.transform = transform;
+	sink.positions = positions;
+	sink.indices = indices;
+
+	if (positions != NULL)
+		sg_ring_table_init(&ring, sink.subdivisions);
+
+	// Non-indexed topologies have no indices to write.
+	if (indices != NULL && !sg_gizmo_topology_indexed(topology))
+		return SG_OK_RETURNED_BUFFER;
+
+	emit(info, &sink);
+
+	if (vertices_length != NULL)
+		*vertices_length = sink.vertices_length;
+	if (indices_length != NULL)
+		*indices_length = sg_gizmo_topology_indexed(topology) ? sink.indices_length : 0;
+	return (positions != NULL || indices != NULL) ? SG_OK_RETURNED_BUFFER : SG_OK_RETURNED_LENGTH;
+}
+
+static inline enum sg_status
+sg_gizmo_emit(
+	void (*emit)(void const* info, struct sg_gizmo_sink* sink),
+	void const* info,
+	const enum sg_gizmo_topology topology,
+	const size_t subdivisions,
+	size_t* vertices_length,
+	struct sg_position* positions,
+	size_t* indices_length,
+	SG_indice* indices
+)
+{
+	return sg_gizmo_emit_transformed(emit, info, topology, subdivisions, NULL,
+	                                 vertices_length, positions, indices_length, indices);
+}
+
+static void
+sg_gizmo_cone_emit(void const* info, struct sg_gizmo_sink* sink)
+{
+	struct sg_gizmo_cone_info const* cone = (struct sg_gizmo_cone_info const*)info;
+	const float cone_height = cone->height;
+	const float cone_radius = cone->radius;
+	const float bottom_y = -(cone_height / 2);
+
+	// Generate bottom circle
+	sg_gizmo_sink_arc(sink,
+	                  (struct sg_position){ 0, bottom_y, 0 },
+	                  (struct sg_position){ cone_radius, 0, 0 },
+	                  (struct sg_position){ 0, 0, cone_radius },
+	                  0, sink->subdivisions, 1);
+
+	// Generate lines from the top to the left, right, front & back
+	const struct sg_position points[5] = {
+		{ 0, cone_height / 2, 0 },
+		{ cone_radius, bottom_y, 0 },
+		{ -cone_radius, bottom_y, 0 },
+		{ 0, bottom_y, cone_radius },
+		{ 0, bottom_y, -cone_radius }
+	};
+	static const unsigned char lines[4][2] = { {0, 1}, {0, 2}, {0, 3}, {0, 4} };
+	sg_gizmo_sink_lines(sink, points, 5, lines, 4);
+}
+
+enum sg_status
+sg_gizmo_cone_vertices(
+	struct sg_gizmo_cone_info* cone,
+	size_t* length,
+	struct sg_position* positions)
+{
+	if (!cone) return SG_ERR_INFO_NOT_PROVIDED;
 	
-/** @}*/
+	if (!positions && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
 
+	return sg_gizmo_emit(sg_gizmo_cone_emit, cone, cone->topology, cone->subdivisions,
+	                     positions ? NULL : length, positions, NULL, NULL);
+}
 
-/** @addtogroup materials
- *  @{
- */
+enum sg_status
+sg_gizmo_cone_indices(
+	struct sg_gizmo_cone_info* cone,
+	size_t* length,
+	SG_indice* indices)
+{
+	if (!cone) return SG_ERR_INFO_NOT_PROVIDED;
 
-struct sg_material {
-	struct sg_vec3f ambient;  /// ambient color for material.
-	struct sg_vec3f diffuse;  /// diffuse color for material.
-	struct sg_vec3f specular; /// specular color for material.
-	float shininess;          /// shininess color for material.
-};
+	if (!indices && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
 
-/**
- * @brief get the material properties of gold. * @return the material.
- */
-SG_API_EXPORT
-struct sg_material
-sg_material_gold(); 
+	return sg_gizmo_emit(sg_gizmo_cone_emit, cone, cone->topology, cone->subdivisions,
+	                     NULL, NULL, indices ? NULL : length, indices);
+}
 
-/**
- * @brief get the material properties of obsidian.
- * @return the material.
- */
-SG_API_EXPORT
-struct sg_material
-sg_material_obsidian(); 
-	
-/**
- * @brief get the material properties of ruby.
- * @return the material.
- */
-SG_API_EXPORT
-struct sg_material
-sg_material_ruby(); 
+static void
+sg_gizmo_sphere_emit(void const* info, struct sg_gizmo_sink* sink)
+{
+	struct sg_gizmo_sphere_info const* sphere = (struct sg_gizmo_sphere_info const*)info;
+	const float sphere_radius = sphere->radius;
+	const struct sg_position center{ 0, 0, 0 };
 
-/**
- * @brief get the material properties of emerald.
- * @return the material.
- */
-SG_API_EXPORT
-struct sg_material
-sg_material_emerald(); 
+	// Generate x band
+	sg_gizmo_sink_arc(sink, center,
+	                  (struct sg_position){ 0, sphere_radius, 0 },
+	                  (struct sg_position){ 0, 0, sphere_radius },
+	                  0, sink->subdivisions, 1);
 
-/**
- * @brief get the material properties of a standard flat white.
- * @return the material.
- */
-SG_API_EXPORT
-struct sg_material
-sg_material_default_flat_white();
+	// Generate y band
+	sg_gizmo_sink_arc(sink, center,
+	                  (struct sg_position){ sphere_radius, 0, 0 },
+	                  (struct sg_position){ 0, 0, sphere_radius },
+	                  0, sink->subdivisions, 1);
+
+	// Generate z band
+	sg_gizmo_sink_arc(sink, center,
+	                  (struct sg_position){ sphere_radius, 0, 0 },
+	                  (struct sg_position){ 0, sphere_radius, 0 },
+	                  0, sink->subdivisions, 1);
+}
+
+enum sg_status
+sg_gizmo_sphere_vertices(
+	struct sg_gizmo_sphere_info* sphere,
+	size_t* length,
+	struct sg_position* positions)
+{
+	if (!sphere) return SG_ERR_INFO_NOT_PROVIDED;
 	
-/** @}*/
+	if (!positions && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
 
+	return sg_gizmo_emit(sg_gizmo_sphere_emit, sphere, sphere->topology, sphere->subdivisions,
+	                     positions ? NULL : length, positions, NULL, NULL);
+}
 
-/** ***********************************************************
- * Implementation
- */
-#ifdef SIMPLE_GEOMETRY_IMPLEMENTATION
+enum sg_status
+sg_gizmo_sphere_indices(
+	struct sg_gizmo_sphere_info* sphere,
+	size_t* length,
+	SG_indice* indices)
+{
+	if (!sphere) return SG_ERR_INFO_NOT_PROVIDED;
 
-bool
-sg_success(const enum sg_status status)
+	if (!indices && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	return sg_gizmo_emit(sg_gizmo_sphere_emit, sphere, sphere->topology, sphere->subdivisions,
+	                     NULL, NULL, indices ? NULL : length, indices);
+}
+
+static void
+sg_gizmo_cube_emit(void const* info, struct sg_gizmo_sink* sink)
 {
-	switch (status) {
-	case SG_OK_RETURNED_BUFFER:
-	case SG_OK_RETURNED_LENGTH:
-	case SG_OK_COPIED_TO_DST:
-		return true;
-	default:
-		return false;
+	struct sg_gizmo_cube_info const* cube = (struct sg_gizmo_cube_info const*)info;
+	const float cube_width = cube->width;
+	const float cube_height = cube->height;
+	const float cube_depth = cube->depth;
+
+	// ftl, ftr, fbl, fbr, btl, btr, bbl & bbr corners.
+	const struct sg_position points[8] = {
+		{ cube_width / 2, cube_height / 2, -(cube_depth / 2) },
+		{ -(cube_width / 2), cube_height / 2, -(cube_depth / 2) },
+		{ cube_width / 2, -(cube_height / 2), -(cube_depth / 2) },
+		{ -(cube_width / 2), -(cube_height / 2), -(cube_depth / 2) },
+		{ cube_width / 2, cube_height / 2, cube_depth / 2 },
+		{ -(cube_width / 2), cube_height / 2, cube_depth / 2 },
+		{ cube_width / 2, -(cube_height / 2), cube_depth / 2 },
+		{ -(cube_width / 2), -(cube_height / 2), cube_depth / 2 }
+	};
+	static const unsigned char lines[12][2] = {
+		{0, 1}, {2, 3}, {4, 5}, {6, 7},
+		{0, 4}, {2, 6}, {1, 5}, {3, 7},
+		{1, 3}, {5, 7}, {0, 2}, {4, 6}
 	};
+	sg_gizmo_sink_lines(sink, points, 8, lines, 12);
 }
+
+enum sg_status
+sg_gizmo_cube_vertices(
+	struct sg_gizmo_cube_info* cube,
+	size_t* length,
+	struct sg_position* positions)
+{
+	if (!cube) return SG_ERR_INFO_NOT_PROVIDED;
 	
-const char*
-sg_status_string(const enum sg_status status)
+	if (!positions && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	return sg_gizmo_emit(sg_gizmo_cube_emit, cube, cube->topology, 0,
+	                     positions ? NULL : length, positions, NULL, NULL);
+}
+
+enum sg_status
+sg_gizmo_cube_indices(
+	struct sg_gizmo_cube_info* cube,
+	size_t* length,
+	SG_indice* indices)
 {
-	switch (status) {
-	case SG_OK_RETURNED_BUFFER:                      return "SG_OK_RETURNED_BUFFER"; 
-	case SG_OK_RETURNED_LENGTH:                      return "SG_OK_RETURNED_LENGTH";
-	case SG_OK_COPIED_TO_DST:                        return "SG_OK_COPIED_TO_DST";
-	case SG_ERR_NULLPTR_INPUT:                       return "SG_ERR_NULLPTR_INPUT";
-	case SG_ERR_ZEROSIZE_INPUT:                      return "SG_ERR_ZEROSIZE_INPUT";
-	case SG_ERR_INFO_NOT_PROVIDED:                   return "SG_ERR_INFO_NOT_PROVIDED";
-	case SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1: return "SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1";
-	case SG_ERR_DSTLEN_NOT_PROVIDED:                 return "SG_ERR_DSTLEN_NOT_PROVIDED";
-	case SG_ERR_SRCBLKSIZE_LESSTHAN_SRCSTRIDE:       return "SG_ERR_SRCBLKSIZE_LESSTHAN_SRCSTRIDE";
-	case SG_ERR_SRCBLKSIZE_LESSTHAN_DSTSTRIDE:       return "SG_ERR_SRCBLKSIZE_LESSTHAN_DSTSTRIDE";
-	case SG_ERR_NOT_IMPLEMENTED_YET:                 return "SG_ERR_NOT_IMPLEMENTED_YET";
-	case SG_ERR_VERTICES_NOT_DIVISIBLE_BY_3:         return "SG_ERR_VERTICES_NOT_DIVISIBLE_BY_3";
+	if (!cube) return SG_ERR_INFO_NOT_PROVIDED;
+
+	if (!indices && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	return sg_gizmo_emit(sg_gizmo_cube_emit, cube, cube->topology, 0,
+	                     NULL, NULL, indices ? NULL : length, indices);
+}
+
+/* Capsules are built from quarters of the gizmo circle. */
+static inline size_t
+sg_gizmo_capsule_subdivisions(struct sg_gizmo_capsule_info const* capsule)
+{
+	const size_t subdivisions = (capsule->subdivisions > 0)
+		? capsule->subdivisions
+		: SG_GIZMO_CIRCLE_SUBDIVISIONS;
+	return (subdivisions + 3) / 4 * 4;
+}
+
+static void
+sg_gizmo_capsule_emit(void const* info, struct sg_gizmo_sink* sink)
+{
+	struct sg_gizmo_capsule_info const* capsule = (struct sg_gizmo_capsule_info const*)info;
+	const float capsule_diameter = capsule->diameter;
+	const float radius = capsule_diameter / 2;
+	const float capsule_height = (capsule->height < radius) ? radius : capsule->height;
+	const size_t gizmo_half_circle = sink->subdivisions / 2;
+	const size_t gizmo_quarter_circle = sink->subdivisions / 4;
+
+	const float side_top = (capsule_height/2 - radius);
+	const float side_bot = -(capsule_height/2 - radius);
+	const struct sg_position top{ 0, side_top, 0 };
+	const struct sg_position bot{ 0, side_bot, 0 };
+	const struct sg_position x_axis{ radius, 0, 0 };
+	const struct sg_position y_axis{ 0, radius, 0 };
+	const struct sg_position z_axis{ 0, 0, radius };
+
+	// Generate top x & y bands, half circles over the top
+	const size_t top_start = gizmo_half_circle + gizmo_quarter_circle;
+	const size_t top_stop = sink->subdivisions + gizmo_quarter_circle;
+	sg_gizmo_sink_arc(sink, top, y_axis, z_axis, top_start, top_stop, 0);
+	sg_gizmo_sink_arc(sink, top, y_axis, x_axis, top_start, top_stop, 0);
+
+	// Generate top band
+	sg_gizmo_sink_arc(sink, top, x_axis, z_axis, 0, sink->subdivisions, 0);
+
+	// Generate bot x & y bands, half circles under the bottom
+	const size_t bot_start = gizmo_quarter_circle;
+	const size_t bot_stop = bot_start + gizmo_half_circle;
+	sg_gizmo_sink_arc(sink, bot, y_axis, z_axis, bot_start, bot_stop, 0);
+	sg_gizmo_sink_arc(sink, bot, y_axis, x_axis, bot_start, bot_stop, 0);
+
+	// Generate bottom band
+	sg_gizmo_sink_arc(sink, bot, x_axis, z_axis, 0, sink->subdivisions, 0);
+
+	// Generate front, back, left & right sides
+	const struct sg_position points[8] = {
+		{ 0, side_bot, radius },
+		{ 0, side_top, radius },
+		{ 0, side_bot, -radius },
+		{ 0, side_top, -radius },
+		{ -radius, side_bot, 0 },
+		{ -radius, side_top, 0 },
+		{ radius, side_bot, 0 },
+		{ radius, side_top, 0 }
 	};
-	return "SG_UNKNOWN_STATUS";
+	static const unsigned char lines[4][2] = { {0, 1}, {2, 3}, {4, 5}, {6, 7} };
+	sg_gizmo_sink_lines(sink, points, 8, lines, 4);
 }
 
 enum sg_status
-sg_memcpy(
-	const void* src,
-	const size_t n,
-	void* dst
-)
+sg_gizmo_capsule_vertices(
+	struct sg_gizmo_capsule_info* capsule,
+	size_t* length,
+	struct sg_position* positions)
 {
-	size_t i;
-	if (src == NULL || dst == NULL)
-		return SG_ERR_NULLPTR_INPUT;
-	if (n < 1)
-		return SG_ERR_ZEROSIZE_INPUT;
+	if (!capsule) return SG_ERR_INFO_NOT_PROVIDED;
+	
+	if (!positions && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
 
-	for (i = 0; i < n; i++)
-		((char*)dst)[i] = ((char*)src)[i];
-	return SG_OK_COPIED_TO_DST;
+	return sg_gizmo_emit(sg_gizmo_capsule_emit, capsule, capsule->topology,
+	                     sg_gizmo_capsule_subdivisions(capsule),
+	                     positions ? NULL : length, positions, NULL, NULL);
+}
+
+enum sg_status
+sg_gizmo_capsule_indices(
+	struct sg_gizmo_capsule_info* capsule,
+	size_t* length,
+	SG_indice* indices)
+{
+	if (!capsule) return SG_ERR_INFO_NOT_PROVIDED;
+
+	if (!indices && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	return sg_gizmo_emit(sg_gizmo_capsule_emit, capsule, capsule->topology,
+	                     sg_gizmo_capsule_subdivisions(capsule),
+	                     NULL, NULL, indices ? NULL : length, indices);
 }
+
+enum sg_status
+sg_gizmo_cone_vertices_transformed(
+	struct sg_gizmo_cone_info* cone,
+	struct sg_mat3x4 const* transform,
+	size_t* length,
+	struct sg_position* positions)
+{
+	if (!cone) return SG_ERR_INFO_NOT_PROVIDED;
 	
+	if (!positions && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	return sg_gizmo_emit_transformed(sg_gizmo_cone_emit, cone, cone->topology, cone->subdivisions,
+	                                 transform, positions ? NULL : length, positions, NULL, NULL);
+}
+
 enum sg_status
-sg_strided_blockcopy(
-	struct sg_strided_blockcopy_source_info const* source,
-	const size_t stride,
-	void* dst
-)
+sg_gizmo_sphere_vertices_transformed(
+	struct sg_gizmo_sphere_info* sphere,
+	struct sg_mat3x4 const* transform,
+	size_t* length,
+	struct sg_position* positions)
 {
-	size_t i;
-	char* currsrc;
-	char* currdst;
-	enum sg_status copystatus;
+	if (!sphere) return SG_ERR_INFO_NOT_PROVIDED;
+	
+	if (!positions && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
 
-	if (source == NULL)
-		return SG_ERR_INFO_NOT_PROVIDED;
-	if (source->ptr == NULL || dst == NULL)
-		return SG_ERR_NULLPTR_INPUT;
-	if (stride < 1 || source->block_size < 1 || source->block_count < 1)
-		return SG_ERR_ZEROSIZE_INPUT;
-	if (stride < source->block_size)
-		return SG_ERR_SRCBLKSIZE_LESSTHAN_DSTSTRIDE;
+	return sg_gizmo_emit_transformed(sg_gizmo_sphere_emit, sphere, sphere->topology, sphere->subdivisions,
+	                                 transform, positions ? NULL : length, positions, NULL, NULL);
+}
+
+enum sg_status
+sg_gizmo_cube_vertices_transformed(
+	struct sg_gizmo_cube_info* cube,
+	struct sg_mat3x4 const* transform,
+	size_t* length,
+	struct sg_position* positions)
+{
+	if (!cube) return SG_ERR_INFO_NOT_PROVIDED;
 	
-	for (i = 0; i < source->block_count; i++) {
-		currsrc = ((char*)source->ptr) + (i * source->stride);
-		currdst = ((char*)dst) + (i * stride);
-		copystatus = sg_memcpy(currsrc, source->block_size, currdst);
-		if (!sg_success(copystatus))
-			return copystatus;
-	}
+	if (!positions && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
 
-	return SG_OK_COPIED_TO_DST;
+	return sg_gizmo_emit_transformed(sg_gizmo_cube_emit, cube, cube->topology, 0,
+	                                 transform, positions ? NULL : length, positions, NULL, NULL);
 }
+
+enum sg_status
+sg_gizmo_capsule_vertices_transformed(
+	struct sg_gizmo_capsule_info* capsule,
+	struct sg_mat3x4 const* transform,
+	size_t* length,
+	struct sg_position* positions)
+{
+	if (!capsule) return SG_ERR_INFO_NOT_PROVIDED;
 	
-struct sg_vec3f
-sg_vec3f_subtract(const struct sg_vec3f a, const struct sg_vec3f b)
+	if (!positions && !length) return SG_ERR_DSTLEN_NOT_PROVIDED;
+
+	return sg_gizmo_emit_transformed(sg_gizmo_capsule_emit, capsule, capsule->topology,
+	                                 sg_gizmo_capsule_subdivisions(capsule),
+	                                 transform, positions ? NULL : length, positions, NULL, NULL);
+}
+
+size_t
+sg_gizmo_circle_subdivisions(
+	const float screen_radius,
+	const float max_error
+)
 {
-	struct sg_vec3f v;
-	v.x = a.x - b.x;
-	v.y = a.y - b.y;
-	v.z = a.z - b.z;
-	return v;
+	// Segments of a circle of radius r, spanning an angle a, are at most
+	// r * (1 - cos(a / 2)) away from the circle.
+	size_t subdivisions = SG_GIZMO_CIRCLE_SUBDIVISIONS;
+
+	if (max_error <= 0.0f)
+		return subdivisions;
+
+	if (screen_radius <= max_error) {
+		subdivisions = 4;
+	} else {
+		const float half_angle = SG_ACOS(1.0f - max_error / screen_radius);
+		const float segments = SG_PI / half_angle;
+		if (segments < (float)SG_GIZMO_CIRCLE_SUBDIVISIONS) {
+			subdivisions = (size_t)segments;
+			if ((float)subdivisions < segments)
+				subdivisions++;
+		}
+	}
+
+	// Multiples of 4 keep the quarter circles of capsules whole.
+	subdivisions = (subdivisions + 3) / 4 * 4;
+	if (subdivisions < 4)
+		subdivisions = 4;
+	return (subdivisions > SG_GIZMO_CIRCLE_SUBDIVISIONS) ? SG_GIZMO_CIRCLE_SUBDIVISIONS : subdivisions;
 }
 
-struct sg_vec3f
-sg_vec3f_dividef(const struct sg_vec3f a, const float f)
+/* Unit gizmo info of each shape, feeding the emitters of the cache. */
+static enum sg_status
+sg_gizmo_cache_template(
+	struct sg_gizmo_cache* cache,
+	const enum sg_gizmo_shape shape
+)
 {
-	struct sg_vec3f v;
-	v.x = a.x / f;
-	v.y = a.y / f;
-	v.z = a.z / f;
-	return v;
+	struct sg_gizmo_cone_info cone{};
+	struct sg_gizmo_sphere_info sphere{};
+	struct sg_gizmo_cube_info cube{};
+	struct sg_gizmo_capsule_info capsule{};
+	void (*emit)(void const* info, struct sg_gizmo_sink* sink) = NULL;
+	void const* info = NULL;
+	size_t subdivisions = cache->subdivisions;
+	size_t vertices_length;
+	size_t indices_length;
+	enum sg_status status;
+
+	switch (shape) {
+	case SG_GIZMO_SHAPE_CONE:
+		cone.height = 1.0f;
+		cone.radius = 1.0f;
+		emit = sg_gizmo_cone_emit;
+		info = &cone;
+		break;
+	case SG_GIZMO_SHAPE_SPHERE:
+		sphere.radius = 1.0f;
+		emit = sg_gizmo_sphere_emit;
+		info = &sphere;
+		break;
+	case SG_GIZMO_SHAPE_CUBE:
+		cube.width = 1.0f;
+		cube.height = 1.0f;
+		cube.depth = 1.0f;
+		emit = sg_gizmo_cube_emit;
+		info = &cube;
+		break;
+	case SG_GIZMO_SHAPE_CAPSULE:
+		// Caps of radius 1 centred at y = -1 & y = 1.
+		capsule.height = 4.0f;
+		capsule.diameter = 2.0f;
+		capsule.subdivisions = subdivisions;
+		subdivisions = sg_gizmo_capsule_subdivisions(&capsule);
+		emit = sg_gizmo_capsule_emit;
+		info = &capsule;
+		break;
+	default:
+		return SG_ERR_INVALID_RANGE;
+	}
+
+	status = sg_gizmo_emit(emit, info, cache->topology, subdivisions,
+	                       &vertices_length, NULL, &indices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_mesh_allocate(&cache->allocator, SG_ATTRIBUTE_POSITION,
+	                          vertices_length, indices_length, &cache->templates[shape]);
+	if (!sg_success(status))
+		return status;
+
+	sg_gizmo_emit(emit, info, cache->topology, subdivisions,
+	              NULL, cache->templates[shape].positions, NULL, NULL);
+	if (indices_length > 0)
+		sg_gizmo_emit(emit, info, cache->topology, subdivisions,
+		              NULL, NULL, NULL, cache->templates[shape].indices);
+	return SG_OK_RETURNED_BUFFER;
+}
+
+enum sg_status
+sg_gizmo_cache_init(
+	struct sg_gizmo_cache* cache,
+	const enum sg_gizmo_topology topology,
+	const size_t subdivisions,
+	struct sg_allocator const* allocator
+)
+{
+	enum sg_status status;
+
+	if (cache == NULL || allocator == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (allocator->alloc == NULL || allocator->free == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+
+	cache->allocator = *allocator;
+	cache->topology = topology;
+	cache->subdivisions = subdivisions;
+	for (size_t shape = 0; shape < SG_GIZMO_SHAPE_COUNT; shape++)
+		cache->templates[shape] = (struct sg_mesh){};
+
+	for (size_t shape = 0; shape < SG_GIZMO_SHAPE_COUNT; shape++) {
+		status = sg_gizmo_cache_template(cache, (enum sg_gizmo_shape)shape);
+		if (!sg_success(status)) {
+			sg_gizmo_cache_free(cache);
+			return status;
+		}
+	}
+	return SG_OK_RETURNED_BUFFER;
 }
 
-struct sg_vec3f
-sg_vec3f_cross(const struct sg_vec3f a, const struct sg_vec3f b)
+enum sg_status
+sg_gizmo_cache_free(struct sg_gizmo_cache* cache)
 {
-	struct sg_vec3f cross;
-	cross.x = a.y*b.z - a.z*b.y;
-	cross.y = a.z*b.x - a.x*b.z;
-	cross.z = a.x*b.y - a.y*b.x;
-	return cross;
+	if (cache == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+
+	for (size_t shape = 0; shape < SG_GIZMO_SHAPE_COUNT; shape++)
+		sg_mesh_free(&cache->allocator, &cache->templates[shape]);
+	return SG_OK_RETURNED_BUFFER;
 }
 
-float
-sg_vec3f_length(const struct sg_vec3f a)
+struct sg_gizmo_instance
+sg_gizmo_cone_instance(
+	struct sg_gizmo_cone_info const* cone,
+	const struct sg_vec3f center,
+	const uint32_t color
+)
 {
-	return SG_SQUARE_ROOT(a.x*a.x + a.y*a.y + a.z*a.z);
+	struct sg_gizmo_instance instance;
+	instance.center = center;
+	instance.scale = (struct sg_vec3f){ cone->radius, cone->height, cone->radius };
+	instance.stretch = 0.0f;
+	instance.color = color;
+	return instance;
 }
 
-struct sg_vec3f
-sg_vec3f_normalize(const struct sg_vec3f a)
+struct sg_gizmo_instance
+sg_gizmo_sphere_instance(
+	struct sg_gizmo_sphere_info const* sphere,
+	const struct sg_vec3f center,
+	const uint32_t color
+)
 {
-	float length;
-	length = sg_vec3f_length(a);
-	return sg_vec3f_dividef(a, length);
+	struct sg_gizmo_instance instance;
+	instance.center = center;
+	instance.scale = (struct sg_vec3f){ sphere->radius, sphere->radius, sphere->radius };
+	instance.stretch = 0.0f;
+	instance.color = color;
+	return instance;
 }
 
-struct sg_vec3f
-sg_vec3f_from_position(const struct sg_position pos)
+struct sg_gizmo_instance
+sg_gizmo_cube_instance(
+	struct sg_gizmo_cube_info const* cube,
+	const struct sg_vec3f center,
+	const uint32_t color
+)
 {
-	return (struct sg_vec3f) {pos.x, pos.y, pos.z};
+	struct sg_gizmo_instance instance;
+	instance.center = center;
+	instance.scale = (struct sg_vec3f){ cube->width, cube->height, cube->depth };
+	instance.stretch = 0.0f;
+	instance.color = color;
+	return instance;
 }
 
-struct sg_normal
-sg_normal_from_vec3f(const struct sg_vec3f v)
+struct sg_gizmo_instance
+sg_gizmo_capsule_instance(
+	struct sg_gizmo_capsule_info const* capsule,
+	const struct sg_vec3f center,
+	const uint32_t color
+)
 {
-	return (struct sg_normal) {v.x, v.y, v.z};
+	// Same clamping of the height as sg_gizmo_capsule_vertices().
+	const float radius = capsule->diameter / 2;
+	const float capsule_height = (capsule->height < radius) ? radius : capsule->height;
+	struct sg_gizmo_instance instance;
+	instance.center = center;
+	instance.scale = (struct sg_vec3f){ radius, radius, radius };
+	instance.stretch = (capsule_height / 2 - radius) - radius;
+	instance.color = color;
+	return instance;
 }
 
-struct sg_normal
-sg_face_normal(struct sg_position p1,
-			   struct sg_position p2,
-			   struct sg_position p3)
+/* Place 'count' vertices of a unit gizmo, 8 or 4 vertices per iteration
+ * when SIMD is available. Three vectors cover a whole number of vertices,
+ * with the components cycling through the lanes.
+ */
+static inline void
+sg_gizmo_instance_kernel(
+	const float* src,
+	const size_t count,
+	struct sg_gizmo_instance const* instance,
+	float* dst
+)
 {
-	struct sg_vec3f a;
-	struct sg_vec3f b;
-	struct sg_vec3f c;
-	struct sg_vec3f ba;
-	struct sg_vec3f ca;
-	struct sg_vec3f cross;
-
-	/* Calculate the face normal using the formula:
-	 * n = normalize(cross(b-a, c-a)) 
-	 */
-	a = sg_vec3f_from_position(p1);
-	b = sg_vec3f_from_position(p2);
-	c = sg_vec3f_from_position(p3);
+	const float c[3] = { instance->center.x, instance->center.y, instance->center.z };
+	const float s[3] = { instance->scale.x, instance->scale.y, instance->scale.z };
+	const float t[3] = { 0.0f, instance->stretch, 0.0f };
+	size_t j = 0;
+
+#if defined(SG_SIMD_AVX2)
+	{
+		const __m256 sign = _mm256_set1_ps(-0.0f);
+		__m256 c8[3], s8[3], t8[3];
+		for (size_t k = 0; k < 3; k++) {
+			const size_t o = k * 8;
+			c8[k] = _mm256_setr_ps(c[o % 3], c[(o + 1) % 3], c[(o + 2) % 3], c[(o + 3) % 3],
+			                       c[(o + 4) % 3], c[(o + 5) % 3], c[(o + 6) % 3], c[(o + 7) % 3]);
+			s8[k] = _mm256_setr_ps(s[o % 3], s[(o + 1) % 3], s[(o + 2) % 3], s[(o + 3) % 3],
+			                       s[(o + 4) % 3], s[(o + 5) % 3], s[(o + 6) % 3], s[(o + 7) % 3]);
+			t8[k] = _mm256_setr_ps(t[o % 3], t[(o + 1) % 3], t[(o + 2) % 3], t[(o + 3) % 3],
+			                       t[(o + 4) % 3], t[(o + 5) % 3], t[(o + 6) % 3], t[(o + 7) % 3]);
+		}
+		for (; j + 8 <= count; j += 8) {
+			for (size_t k = 0; k < 3; k++) {
+				const __m256 v = _mm256_loadu_ps(src + j * 3 + k * 8);
+				const __m256 moved = _mm256_xor_ps(_mm256_and_ps(v, sign), t8[k]);
+				_mm256_storeu_ps(dst + j * 3 + k * 8,
+				                 _mm256_add_ps(_mm256_add_ps(c8[k], _mm256_mul_ps(v, s8[k])), moved));
+			}
+		}
+	}
+#endif
+#if defined(SG_SIMD_SSE2)
+	{
+		const __m128 sign = _mm_set1_ps(-0.0f);
+		__m128 c4[3], s4[3], t4[3];
+		for (size_t k = 0; k < 3; k++) {
+			const size_t o = k * 4;
+			c4[k] = _mm_setr_ps(c[o % 3], c[(o + 1) % 3], c[(o + 2) % 3], c[(o + 3) % 3]);
+			s4[k] = _mm_setr_ps(s[o % 3], s[(o + 1) % 3], s[(o + 2) % 3], s[(o + 3) % 3]);
+			t4[k] = _mm_setr_ps(t[o % 3], t[(o + 1) % 3], t[(o + 2) % 3], t[(o + 3) % 3]);
+		}
+		for (; j + 4 <= count; j += 4) {
+			for (size_t k = 0; k < 3; k++) {
+				const __m128 v = _mm_loadu_ps(src + j * 3 + k * 4);
+				const __m128 moved = _mm_xor_ps(_mm_and_ps(v, sign), t4[k]);
+				_mm_storeu_ps(dst + j * 3 + k * 4,
+				              _mm_add_ps(_mm_add_ps(c4[k], _mm_mul_ps(v, s4[k])), moved));
+			}
+		}
+	}
+#elif defined(SG_SIMD_NEON)
+	{
+		const uint32x4_t sign = vdupq_n_u32(0x80000000u);
+		float32x4_t c4[3], s4[3];
+		uint32x4_t t4[3];
+		for (size_t k = 0; k < 3; k++) {
+			const size_t o = k * 4;
+			const float cl[4] = { c[o % 3], c[(o + 1) % 3], c[(o + 2) % 3], c[(o + 3) % 3] };
+			const float sl[4] = { s[o % 3], s[(o + 1) % 3], s[(o + 2) % 3], s[(o + 3) % 3] };
+			const float tl[4] = { t[o % 3], t[(o + 1) % 3], t[(o + 2) % 3], t[(o + 3) % 3] };
+			c4[k] = vld1q_f32(cl);
+			s4[k] = vld1q_f32(sl);
+			t4[k] = vreinterpretq_u32_f32(vld1q_f32(tl));
+		}
+		for (; j + 4 <= count; j += 4) {
+			for (size_t k = 0; k < 3; k++) {
+				const float32x4_t v = vld1q_f32(src + j * 3 + k * 4);
+				const float32x4_t moved = vreinterpretq_f32_u32(
+					veorq_u32(vandq_u32(vreinterpretq_u32_f32(v), sign), t4[k]));
+				vst1q_f32(dst + j * 3 + k * 4,
+				          vaddq_f32(vaddq_f32(c4[k], vmulq_f32(v, s4[k])), moved));
+			}
+		}
+	}
+#endif
 
-	ba = sg_vec3f_subtract(b, a); 
-	ca = sg_vec3f_subtract(c, a); 
-	cross = sg_vec3f_cross(ba, ca);
-	return sg_normal_from_vec3f(sg_vec3f_normalize(cross));
+	for (; j < count; j++) {
+		const float y = src[j * 3 + 1];
+		dst[j * 3 + 0] = c[0] + src[j * 3 + 0] * s[0];
+		dst[j * 3 + 1] = (c[1] + y * s[1]) + ((y < 0.0f) ? -t[1] : t[1]);
+		dst[j * 3 + 2] = c[2] + src[j * 3 + 2] * s[2];
+	}
 }
 
 enum sg_status
-sg_calculate_flat_normals(
-	const struct sg_position* vertices,
-	const size_t vertices_length,
-	struct sg_normal* normals
+sg_gizmo_cache_bake(
+	struct sg_gizmo_cache const* cache,
+	const enum sg_gizmo_shape shape,
+	struct sg_gizmo_instance const* instances,
+	const size_t instances_length,
+	size_t* length,
+	struct sg_position* positions
 )
 {
-	struct sg_normal normal;
-	size_t i;
+	struct sg_mesh const* gizmo;
 
-	if (vertices == NULL || normals == NULL)
-		return SG_ERR_NULLPTR_INPUT;
-	if ((vertices_length % 3) != 0)
-		return SG_ERR_VERTICES_NOT_DIVISIBLE_BY_3;
-
-	for (i = 0; i < vertices_length; i += 3) {
-		normal = sg_face_normal(vertices[i],
-								vertices[i+1],
-								vertices[i+2]);
-		
-		normals[i]   = normal;
-		normals[i+1] = normal;
-		normals[i+2] = normal;
+	if (cache == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	if (shape >= SG_GIZMO_SHAPE_COUNT)
+		return SG_ERR_INVALID_RANGE;
+	gizmo = &cache->templates[shape];
+
+	if (positions == NULL) {
+		if (length == NULL)
+			return SG_ERR_DSTLEN_NOT_PROVIDED;
+		*length = gizmo->vertices_length * instances_length;
+		return SG_OK_RETURNED_LENGTH;
 	}
 
+	if (instances == NULL && instances_length > 0)
+		return SG_ERR_NULLPTR_INPUT;
+
+	for (size_t i = 0; i < instances_length; i++)
+		sg_gizmo_instance_kernel((const float*)gizmo->positions, gizmo->vertices_length,
+		                         &instances[i], (float*)(positions + i * gizmo->vertices_length));
 	return SG_OK_RETURNED_BUFFER;
 }
 
 enum sg_status
-sg_indexed_plane_vertices(
-	struct sg_indexed_plane_info const* plane,
+sg_gizmo_cache_bake_indices(
+	struct sg_gizmo_cache const* cache,
+	const enum sg_gizmo_shape shape,
+	const size_t instances_length,
 	size_t* length,
-	struct sg_position* positions,
-	struct sg_normal* normals,
-	struct sg_texcoord* texcoords
+	SG_indice* indices
 )
 {
-	if (plane == NULL)
+	struct sg_mesh const* gizmo;
+
+	if (cache == NULL)
 		return SG_ERR_INFO_NOT_PROVIDED;
-	if (length == NULL)
-		return SG_ERR_DSTLEN_NOT_PROVIDED;
-	if (plane->width_subdivisions < 1 || plane->depth_subdivisions < 1)
-		return SG_ERR_SUBDIVISIONS_MUST_BE_GREATER_THAN_1;
+	if (shape >= SG_GIZMO_SHAPE_COUNT)
+		return SG_ERR_INVALID_RANGE;
+	gizmo = &cache->templates[shape];
 
-	if (positions == NULL && normals == NULL && texcoords == NULL) {
-		*length = plane->width_subdivisions * plane->depth_subdivisions;
+	// Rebased indices must stay below the strip restart index.
+	if (gizmo->indices_length > 0 && gizmo->vertices_length > 0
+	    && instances_length > (size_t)SG_GIZMO_STRIP_RESTART / gizmo->vertices_length)
+		return SG_ERR_INVALID_RANGE;
+
+	if (indices == NULL) {
+		if (length == NULL)
+			return SG_ERR_DSTLEN_NOT_PROVIDED;
+		*length = gizmo->indices_length * instances_length;
 		return SG_OK_RETURNED_LENGTH;
 	}
-	
-	for (size_t w = 0; w < plane->width_subdivisions; w++) {
-		for (size_t h = 0; h < plane->depth_subdivisions; h++) {
-			//TODO: it might be we need depth_subdivisions here
-			size_t index = h + (w * plane->width_subdivisions);
-			float width_scale = plane->width / plane->width_subdivisions;
-			float depth_scale = plane->depth / plane->depth_subdivisions;
-			if (positions != NULL) {
-				sg_position position {
-					.x = width_scale * w,
-					.y = depth_scale * h,
-					.z = 0
-				};
-				positions[index] = position;
-			}
 
-			if (normals != NULL) {
-				sg_normal normal {
-					.x = 0,
-					.y = 0,
-					.z = 1 
-				};
-				normals[index] = normal;
-			}
+	// Rebase the template for each instance, keeping strip restarts.
+	for (size_t i = 0; i < instances_length; i++) {
+		const SG_indice base = (SG_indice)(i * gizmo->vertices_length);
+		SG_indice* dst = indices + i * gizmo->indices_length;
+		for (size_t j = 0; j < gizmo->indices_length; j++) {
+			const SG_indice index = gizmo->indices[j];
+			dst[j] = (index == SG_GIZMO_STRIP_RESTART) ? index : (SG_indice)(index + base);
+		}
+	}
+	return SG_OK_RETURNED_BUFFER;
+}
 
-			if (texcoords != NULL) {
-				sg_texcoord texcoord {
-					.u = width_scale,
-					.v = depth_scale,
-				};
-				texcoords[index] = texcoord;
+/* Place 'count' vertices of a unit gizmo through an affine transform, the
+ * instance folded into the transform beforehand. With SIMD, 4 vertices are
+ * transposed into x, y & z vectors, transformed, and transposed back.
+ */
+static inline void
+sg_gizmo_affine_kernel(
+	const float* src,
+	const size_t count,
+	struct sg_gizmo_instance const* instance,
+	struct sg_mat3x4 const* transform,
+	float* dst
+)
+{
+	const float (*m)[4] = transform->m;
+	float a[3][4];
+	float d[3];
+
+	for (size_t r = 0; r < 3; r++) {
+		a[r][0] = m[r][0] * instance->scale.x;
+		a[r][1] = m[r][1] * instance->scale.y;
+		a[r][2] = m[r][2] * instance->scale.z;
+		a[r][3] = m[r][0] * instance->center.x + m[r][1] * instance->center.y
+		        + m[r][2] * instance->center.z + m[r][3];
+		d[r] = m[r][1] * instance->stretch;
+	}
+
+	size_t j = 0;
+
+#if defined(SG_SIMD_SSE2)
+	{
+		const __m128 sign = _mm_set1_ps(-0.0f);
+		__m128 a4[3][4], d4[3];
+		for (size_t r = 0; r < 3; r++) {
+			for (size_t k = 0; k < 4; k++)
+				a4[r][k] = _mm_set1_ps(a[r][k]);
+			d4[r] = _mm_set1_ps(d[r]);
+		}
+		for (; j + 4 <= count; j += 4) {
+			const __m128 v0 = _mm_loadu_ps(src + j * 3 + 0);
+			const __m128 v1 = _mm_loadu_ps(src + j * 3 + 4);
+			const __m128 v2 = _mm_loadu_ps(src + j * 3 + 8);
+			const __m128 x = _mm_shuffle_ps(v0, _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+			const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1)),
+			                                _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+			const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)), v2, _MM_SHUFFLE(3, 0, 2, 0));
+			const __m128 y_sign = _mm_and_ps(y, sign);
+			__m128 o[3];
+			for (size_t r = 0; r < 3; r++) {
+				o[r] = _mm_add_ps(_mm_mul_ps(a4[r][0], x), _mm_mul_ps(a4[r][1], y));
+				o[r] = _mm_add_ps(o[r], _mm_mul_ps(a4[r][2], z));
+				o[r] = _mm_add_ps(o[r], a4[r][3]);
+				o[r] = _mm_add_ps(o[r], _mm_xor_ps(d4[r], y_sign));
 			}
+			_mm_storeu_ps(dst + j * 3 + 0, _mm_shuffle_ps(_mm_shuffle_ps(o[0], o[1], _MM_SHUFFLE(0, 0, 0, 0)),
+			                                              _mm_shuffle_ps(o[2], o[0], _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(dst + j * 3 + 4, _mm_shuffle_ps(_mm_shuffle_ps(o[1], o[2], _MM_SHUFFLE(1, 1, 1, 1)),
+			                                              _mm_shuffle_ps(o[0], o[1], _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(dst + j * 3 + 8, _mm_shuffle_ps(_mm_shuffle_ps(o[2], o[0], _MM_SHUFFLE(3, 3, 2, 2)),
+			                                              _mm_shuffle_ps(o[1], o[2], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
 		}
 	}
+#elif defined(SG_SIMD_NEON)
+	{
+		const uint32x4_t sign = vdupq_n_u32(0x80000000u);
+		for (; j + 4 <= count; j += 4) {
+			const float32x4x3_t v = vld3q_f32(src + j * 3);
+			const uint32x4_t y_sign = vandq_u32(vreinterpretq_u32_f32(v.val[1]), sign);
+			float32x4x3_t o;
+			for (size_t r = 0; r < 3; r++) {
+				float32x4_t w = vaddq_f32(vmulq_n_f32(v.val[0], a[r][0]), vmulq_n_f32(v.val[1], a[r][1]));
+				w = vaddq_f32(w, vmulq_n_f32(v.val[2], a[r][2]));
+				w = vaddq_f32(w, vdupq_n_f32(a[r][3]));
+				o.val[r] = vaddq_f32(w, vreinterpretq_f32_u32(
+					veorq_u32(vreinterpretq_u32_f32(vdupq_n_f32(d[r])), y_sign)));
+			}
+			vst3q_f32(dst + j * 3, o);
+		}
+	}
+#endif
 
-	return SG_OK_RETURNED_BUFFER;
+	for (; j < count; j++) {
+		const float x = src[j * 3 + 0];
+		const float y = src[j * 3 + 1];
+		const float z = src[j * 3 + 2];
+		const float sign = (y < 0.0f) ? -1.0f : 1.0f;
+		dst[j * 3 + 0] = a[0][0] * x + a[0][1] * y + a[0][2] * z + a[0][3] + sign * d[0];
+		dst[j * 3 + 1] = a[1][0] * x + a[1][1] * y + a[1][2] * z + a[1][3] + sign * d[1];
+		dst[j * 3 + 2] = a[2][0] * x + a[2][1] * y + a[2][2] * z + a[2][3] + sign * d[2];
+	}
 }
 
 enum sg_status
-sg_indexed_plane_indices(
-	struct sg_indexed_plane_info const* plane,
+sg_gizmo_cache_bake_transformed(
+	struct sg_gizmo_cache const* cache,
+	const enum sg_gizmo_shape shape,
+	struct sg_gizmo_instance const* instances,
+	struct sg_mat3x4 const* transforms,
+	const size_t instances_length,
 	size_t* length,
-	SG_indice* indices
+	struct sg_position* positions
 )
 {
-	(void)(plane);
-	(void)(length);
-	(void)(indices);
-	return SG_ERR_NOT_IMPLEMENTED_YET;
-}
+	struct sg_mesh const* gizmo;
 
+	if (cache == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	if (shape >= SG_GIZMO_SHAPE_COUNT)
+		return SG_ERR_INVALID_RANGE;
+	gizmo = &cache->templates[shape];
+
+	if (positions == NULL) {
+		if (length == NULL)
+			return SG_ERR_DSTLEN_NOT_PROVIDED;
+		*length = gizmo->vertices_length * instances_length;
+		return SG_OK_RETURNED_LENGTH;
+	}
 
-#if 0
-	const struct sg_normal _normals[36] = {
-		{0.0f,  0.0f, -1.0f}, {0.0f,  0.0f, -1.0f},  {0.0f,  0.0f, -1.0f}, 
-		{0.0f,  0.0f, -1.0f}, {0.0f,  0.0f, -1.0f},  {0.0f,  0.0f, -1.0f}, 
+	if ((instances == NULL || transforms == NULL) && instances_length > 0)
+		return SG_ERR_NULLPTR_INPUT;
 
-		{0.0f,  0.0f, 1.0f}, {0.0f,  0.0f, 1.0f}, {0.0f,  0.0f, 1.0f},
-		{0.0f,  0.0f, 1.0f}, {0.0f,  0.0f, 1.0f}, {0.0f,  0.0f, 1.0f},
+	for (size_t i = 0; i < instances_length; i++)
+		sg_gizmo_affine_kernel((const float*)gizmo->positions, gizmo->vertices_length,
+		                       &instances[i], &transforms[i],
+		                       (float*)(positions + i * gizmo->vertices_length));
+	return SG_OK_RETURNED_BUFFER;
+}
 
-		{1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f},
-		{1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f},
+enum sg_status
+sg_debug_draw_init(
+	struct sg_debug_draw* draw,
+	const size_t capacity,
+	const size_t subdivisions,
+	const enum sg_debug_draw_overflow overflow,
+	struct sg_allocator const* allocator
+)
+{
+	enum sg_status status;
 
-		{1.0f,  0.0f,  0.0f},{1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f},
-		{1.0f,  0.0f,  0.0f},{1.0f,  0.0f,  0.0f}, {1.0f,  0.0f,  0.0f},
+	if (draw == NULL || allocator == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (capacity == 0)
+		return SG_ERR_ZEROSIZE_INPUT;
 
-		{0.0f, -1.0f,  0.0f}, {0.0f, -1.0f,  0.0f}, {0.0f, -1.0f,  0.0f},
-		{0.0f, -1.0f,  0.0f}, {0.0f, -1.0f,  0.0f}, {0.0f, -1.0f,  0.0f},
+	status = sg_gizmo_cache_init(&draw->cache, SG_GIZMO_TOPOLOGY_LINE_LIST, subdivisions, allocator);
+	if (!sg_success(status))
+		return status;
+
+	draw->overflow = overflow;
+	draw->capacity = capacity;
+	draw->back = 0;
+	for (size_t i = 0; i < 2; i++) {
+		draw->buffers[i] = (struct sg_debug_draw_buffer){};
+		draw->buffers[i].positions = (struct sg_position*)allocator->alloc(
+			capacity * sizeof(draw->buffers[i].positions[0]), allocator->user);
+		draw->buffers[i].colors = (uint32_t*)allocator->alloc(
+			capacity * sizeof(draw->buffers[i].colors[0]), allocator->user);
+	}
 
-		{0.0f,  1.0f,  0.0f}, {0.0f,  1.0f,  0.0f}, {0.0f,  1.0f,  0.0f},
-		{0.0f,  1.0f,  0.0f}, {0.0f,  1.0f,  0.0f}, {0.0f,  1.0f,  0.0f}
-	};
-#endif
+	for (size_t i = 0; i < 2; i++) {
+		if (draw->buffers[i].positions == NULL || draw->buffers[i].colors == NULL) {
+			sg_debug_draw_free(draw);
+			return SG_ERR_ALLOCATION_FAILED;
+		}
+	}
+	return SG_OK_RETURNED_BUFFER;
+}
 
 enum sg_status
-sg_cube_vertices(
-	struct sg_cube_info* info,
-	size_t* length,
-	struct sg_position* positions,
-	struct sg_normal* normals,
-	struct sg_texcoord* texcoords
-)
+sg_debug_draw_free(struct sg_debug_draw* draw)
 {
-	if (info == NULL)
-		return SG_ERR_INFO_NOT_PROVIDED;
+	struct sg_allocator const* allocator;
 
-	if (length == NULL)
-		return SG_ERR_DSTLEN_NOT_PROVIDED;
+	if (draw == NULL)
+		return SG_ERR_NULLPTR_INPUT;
 
-	const struct sg_normal _normals[36] = {
-		{-1.0f,  0.0f,  0.0f},
-		{-1.0f,  0.0f,  0.0f},
-		{-1.0f,  0.0f,  0.0f},
-		{-1.0f,  0.0f,  0.0f},
-		{-1.0f,  0.0f,  0.0f},
-		{-1.0f,  0.0f,  0.0f},
-
-		{0.0f,  0.0f, -1.0f},
-		{0.0f,  0.0f, -1.0f},
-		{0.0f,  0.0f, -1.0f},
-		{0.0f,  0.0f, -1.0f},
-		{0.0f,  0.0f, -1.0f},
-		{0.0f,  0.0f, -1.0f},
-
-		{0.0f, -1.0f,  0.0f},
-		{0.0f, -1.0f,  0.0f},
-		{0.0f, -1.0f,  0.0f},
-		{0.0f, -1.0f,  0.0f},
-		{0.0f, -1.0f,  0.0f},
-		{0.0f, -1.0f,  0.0f},
-		
-		{0.0f,  1.0f,  0.0f},
-		{0.0f,  1.0f,  0.0f},
-		{0.0f,  1.0f,  0.0f},
-		{0.0f,  1.0f,  0.0f},
-		{0.0f,  1.0f,  0.0f},
-		{0.0f,  1.0f,  0.0f},
-		
-		{1.0f,  0.0f,  0.0f},
-		{1.0f,  0.0f,  0.0f},
-		{1.0f,  0.0f,  0.0f},
-		{1.0f,  0.0f,  0.0f},
-		{1.0f,  0.0f,  0.0f},
-		{1.0f,  0.0f,  0.0f},
-		
-		{0.0f,  0.0f,  1.0f},
-		{0.0f,  0.0f,  1.0f},
-		{0.0f,  0.0f,  1.0f},
-		{0.0f,  0.0f,  1.0f},
-		{0.0f,  0.0f,  1.0f},
-		{0.0f,  0.0f,  1.0f}
-	};
+	allocator = &draw->cache.allocator;
+	for (size_t i = 0; i < 2; i++) {
+		sg_allocator_free(allocator, draw->buffers[i].positions,
+		                  draw->capacity * sizeof(draw->buffers[i].positions[0]));
+		sg_allocator_free(allocator, draw->buffers[i].colors,
+		                  draw->capacity * sizeof(draw->buffers[i].colors[0]));
+		draw->buffers[i] = (struct sg_debug_draw_buffer){};
+	}
+	draw->capacity = 0;
+	return sg_gizmo_cache_free(&draw->cache);
+}
 
-	//https://github.com/KhronosGroup/Vulkan-Tools/blob/main/cube/cube.cpp
-	const struct sg_position _positions[36] = {
-		{-info->width, -info->height, -info->depth},  // -X side
-		{-info->width, -info->height,  info->depth},
-		{-info->width,  info->height,  info->depth},
-		{-info->width,  info->height,  info->depth},
-		{-info->width,  info->height, -info->depth},
-		{-info->width, -info->height, -info->depth},
-		{-info->width, -info->height, -info->depth},  // -Z side
-		{ info->width,  info->height, -info->depth},
-		{ info->width, -info->height, -info->depth},
-		{-info->width, -info->height, -info->depth},
-		{-info->width,  info->height, -info->depth},
-		{ info->width,  info->height, -info->depth},
-		{-info->width, -info->height, -info->depth},  // -Y side
-		{ info->width, -info->height, -info->depth},
-		{ info->width, -info->height,  info->depth},
-		{-info->width, -info->height, -info->depth},
-		{ info->width, -info->height,  info->depth},
-		{-info->width, -info->height,  info->depth},
-		{-info->width,  info->height, -info->depth},  // +Y side
-		{-info->width,  info->height,  info->depth},
-		{ info->width,  info->height,  info->depth},
-		{-info->width,  info->height, -info->depth},
-		{ info->width,  info->height,  info->depth},
-		{ info->width,  info->height, -info->depth},
-		{ info->width,  info->height, -info->depth},  // +X side
-		{ info->width,  info->height,  info->depth},
-		{ info->width, -info->height,  info->depth},
-		{ info->width, -info->height,  info->depth},
-		{ info->width, -info->height, -info->depth},
-		{ info->width,  info->height, -info->depth},
-		{-info->width,  info->height,  info->depth},  // +Z side
-		{-info->width, -info->height,  info->depth},
-		{ info->width,  info->height,  info->depth},
-		{-info->width, -info->height,  info->depth},
-		{ info->width, -info->height,  info->depth},
-		{ info->width,  info->height,  info->depth}
-	};
+enum sg_status
+sg_debug_draw_swap(
+	struct sg_debug_draw* draw,
+	struct sg_debug_draw_buffer* frame
+)
+{
+	if (draw == NULL || frame == NULL)
+		return SG_ERR_NULLPTR_INPUT;
 
-	const struct sg_texcoord _texcoords[36] = {
-		{0.0f, 1.0f},  // -X side
-		{1.0f, 1.0f},
-		{1.0f, 0.0f},
-		{1.0f, 0.0f},
-		{0.0f, 0.0f},
-		{0.0f, 1.0f},
-
-		{1.0f, 1.0f},  // -Z side
-		{0.0f, 0.0f},
-		{0.0f, 1.0f},
-		{1.0f, 1.0f},
-		{1.0f, 0.0f},
-		{0.0f, 0.0f},
-
-		{1.0f, 0.0f},  // -Y side
-		{1.0f, 1.0f},
-		{0.0f, 1.0f},
-		{1.0f, 0.0f},
-		{0.0f, 1.0f},
-		{0.0f, 0.0f},
-
-		{1.0f, 0.0f},  // +Y side
-		{0.0f, 0.0f},
-		{0.0f, 1.0f},
-		{1.0f, 0.0f},
-		{0.0f, 1.0f},
-		{1.0f, 1.0f},
-
-		{1.0f, 0.0f},  // +X side
-		{0.0f, 0.0f},
-		{0.0f, 1.0f},
-		{0.0f, 1.0f},
-		{1.0f, 1.0f},
-		{1.0f, 0.0f},
-
-		{0.0f, 0.0f},  // +Z side
-		{0.0f, 1.0f},
-		{1.0f, 0.0f},
-		{0.0f, 1.0f},
-		{1.0f, 1.0f},
-		{1.0f, 0.0f},
-	};
-	
+	*frame = draw->buffers[draw->back];
+	draw->back ^= 1;
+	draw->buffers[draw->back].length = 0;
+	draw->buffers[draw->back].dropped = 0;
+	return SG_OK_RETURNED_BUFFER;
+}
 
-	size_t i;
-	if (positions == NULL && normals == NULL && texcoords == NULL) {
-		*length = 36;
-		return SG_OK_RETURNED_LENGTH;
+/* Make room for 'length' vertices of one color in the back buffer. The
+ * positions to write are NULL when the request is dropped or rejected.
+ */
+static enum sg_status
+sg_debug_draw_reserve(
+	struct sg_debug_draw* draw,
+	const size_t length,
+	const uint32_t color,
+	struct sg_position** positions
+)
+{
+	struct sg_debug_draw_buffer* buffer = &draw->buffers[draw->back];
+
+	*positions = NULL;
+	if (length > draw->capacity - buffer->length) {
+		if (draw->overflow == SG_DEBUG_DRAW_OVERFLOW_ERROR)
+			return SG_ERR_BUFFER_FULL;
+		buffer->dropped++;
+		return SG_OK_RETURNED_BUFFER;
 	}
-	
-	if (normals != NULL)
-		for (i = 0; i < 36; ++i)
-			normals[i] = _normals[i];
 
-	if (positions != NULL)
-		for (i = 0; i < 36; ++i)
-			positions[i] = _positions[i];
-
-	if (texcoords != NULL)
-		for (i = 0; i < 36; ++i)
-			texcoords[i] = _texcoords[i];
-	
+	for (size_t i = 0; i < length; i++)
+		buffer->colors[buffer->length + i] = color;
+	*positions = buffer->positions + buffer->length;
+	buffer->length += length;
 	return SG_OK_RETURNED_BUFFER;
 }
 
+enum sg_status
+sg_debug_draw_line(
+	struct sg_debug_draw* draw,
+	const struct sg_vec3f a,
+	const struct sg_vec3f b,
+	const uint32_t color
+)
+{
+	struct sg_position* positions;
+	enum sg_status status;
+
+	if (draw == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+
+	status = sg_debug_draw_reserve(draw, 2, color, &positions);
+	if (positions == NULL)
+		return status;
+
+	positions[0] = (struct sg_position){ SG_EXPAND_XYZ(a) };
+	positions[1] = (struct sg_position){ SG_EXPAND_XYZ(b) };
+	return status;
+}
 
+static enum sg_status
+sg_debug_draw_gizmo(
+	struct sg_debug_draw* draw,
+	const enum sg_gizmo_shape shape,
+	struct sg_gizmo_instance const* instance,
+	struct sg_mat3x4 const* transform
+)
+{
+	struct sg_mesh const* gizmo = &draw->cache.templates[shape];
+	struct sg_position* positions;
+	enum sg_status status;
+
+	status = sg_debug_draw_reserve(draw, gizmo->vertices_length, instance->color, &positions);
+	if (positions == NULL)
+		return status;
+
+	if (transform == NULL)
+		sg_gizmo_instance_kernel((const float*)gizmo->positions, gizmo->vertices_length,
+		                         instance, (float*)positions);
+	else
+		sg_gizmo_affine_kernel((const float*)gizmo->positions, gizmo->vertices_length,
+		                       instance, transform, (float*)positions);
+	return status;
+}
 
 enum sg_status
-sg_indexed_sphere_vertices(
-	struct sg_indexed_sphere_info* info,
-	size_t* length,
-	struct sg_position* positions,
-	struct sg_normal* normals,
-	struct sg_texcoord* texcoords
+sg_debug_draw_cone(
+	struct sg_debug_draw* draw,
+	struct sg_gizmo_cone_info const* cone,
+	struct sg_mat3x4 const* transform,
+	const uint32_t color
 )
-/**
- * Original Reference:
- * https://www.3dgep.com/texturing-and-lighting-with-opengl-and-glsl/#Creating_a_Sphere
- */
 {
-	if (info == NULL)
+	struct sg_gizmo_instance instance;
+
+	if (draw == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (cone == NULL)
 		return SG_ERR_INFO_NOT_PROVIDED;
 
-	if (length == NULL)
-		return SG_ERR_DSTLEN_NOT_PROVIDED;
+	instance = sg_gizmo_cone_instance(cone, (struct sg_vec3f){}, color);
+	return sg_debug_draw_gizmo(draw, SG_GIZMO_SHAPE_CONE, &instance, transform);
+}
 
-	if (positions == NULL && normals == NULL && texcoords == NULL) {
-		*length = (info->slices+1)*(info->stacks+1);
-		return SG_OK_RETURNED_LENGTH;
-	}
+enum sg_status
+sg_debug_draw_sphere(
+	struct sg_debug_draw* draw,
+	struct sg_gizmo_sphere_info const* sphere,
+	struct sg_mat3x4 const* transform,
+	const uint32_t color
+)
+{
+	struct sg_gizmo_instance instance;
 
-	size_t n = 0;
-	for (size_t i = 0; i <= info->stacks; ++i) {
-		sg_texcoord texcoord{
-			.u = 0,
-			.v = 0
-		};
-
-		texcoord.v = i / (float)info->stacks;
-		float phi = texcoord.v * SG_PI;
-
-		for (size_t j = 0; j <= info->slices; ++j) {
-			texcoord.u = j / (float)info->slices;
-			float theta = texcoord.u * SG_2PI;
-			sg_normal normal{
-				.x = SG_COS(theta) * SG_SIN(phi),
-				.y = SG_COS(phi),
-				.z = SG_SIN(theta) * SG_SIN(phi)
-			};
+	if (draw == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (sphere == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	instance = sg_gizmo_sphere_instance(sphere, (struct sg_vec3f){}, color);
+	return sg_debug_draw_gizmo(draw, SG_GIZMO_SHAPE_SPHERE, &instance, transform);
+}
 
-			if (normals != NULL)
-				normals[n] = normal;
+enum sg_status
+sg_debug_draw_cube(
+	struct sg_debug_draw* draw,
+	struct sg_gizmo_cube_info const* cube,
+	struct sg_mat3x4 const* transform,
+	const uint32_t color
+)
+{
+	struct sg_gizmo_instance instance;
 
-			if (positions != NULL) {
-				sg_position position{
-					.x = normal.x * info->radius,
-					.y = normal.y * info->radius,
-					.z = normal.z * info->radius
-				};
-				positions[n] = position;
-			}
-			
-			if (texcoords != NULL)
-				texcoords[n] = texcoord;
-			n++;
-		}
-	}
+	if (draw == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (cube == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
 
-	return SG_OK_RETURNED_BUFFER;
+	instance = sg_gizmo_cube_instance(cube, (struct sg_vec3f){}, color);
+	return sg_debug_draw_gizmo(draw, SG_GIZMO_SHAPE_CUBE, &instance, transform);
 }
 
 enum sg_status
-sg_indexed_sphere_indices(
-	struct sg_indexed_sphere_info* info,
-	size_t* length,
-	SG_indice* indices
+sg_debug_draw_capsule(
+	struct sg_debug_draw* draw,
+	struct sg_gizmo_capsule_info const* capsule,
+	struct sg_mat3x4 const* transform,
+	const uint32_t color
 )
 {
-	if (info == NULL)
+	struct sg_gizmo_instance instance;
+
+	if (draw == NULL)
+		return SG_ERR_NULLPTR_INPUT;
+	if (capsule == NULL)
 		return SG_ERR_INFO_NOT_PROVIDED;
 
-	if (length == NULL)
-		return SG_ERR_DSTLEN_NOT_PROVIDED;
-	
-	if (indices == NULL) {
-		*length = (info->slices * info->stacks + info->slices) * 6;
-		return SG_OK_RETURNED_LENGTH;
-	}
-	
-	size_t n = 0;
-	for (size_t i = 0; i < info->slices * info->stacks + info->slices; ++i) {
-		indices[n++] = i;
-		indices[n++] = i + info->slices + 1;
-		indices[n++] = i + info->slices;
+	instance = sg_gizmo_capsule_instance(capsule, (struct sg_vec3f){}, color);
+	return sg_debug_draw_gizmo(draw, SG_GIZMO_SHAPE_CAPSULE, &instance, transform);
+}
 
-		indices[n++] = i + info->slices + 1;
-		indices[n++] = i;
-		indices[n++] = i + 1;
-	}
+/* Move the used part of a buffer into a newly allocated one. */
+static inline void
+sg_move_buffer(
+	struct sg_allocator const* allocator,
+	void** buffer,
+	void* grown,
+	const size_t used_size,
+	const size_t old_size
+)
+{
+	if (*buffer != NULL && used_size > 0)
+		sg_memcpy_unchecked((const unsigned char*)*buffer, used_size, (unsigned char*)grown);
+	sg_allocator_free(allocator, *buffer, old_size);
+	*buffer = grown;
+}
+
+static inline size_t
+sg_grown_capacity(const size_t capacity, const size_t required)
+{
+	size_t grown = (capacity < 64) ? 64 : capacity;
+	while (grown < required)
+		grown *= 2;
+	return grown;
+}
+
+enum sg_status
+sg_mesh_batch_init(
+	struct sg_mesh_batch* batch,
+	const unsigned int attributes,
+	struct sg_allocator const* allocator
+)
+{
+	enum sg_status status;
 
+	if (batch == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+	status = sg_generate_check(attributes, allocator, &batch->mesh);
+	if (!sg_success(status))
+		return status;
+
+	batch->allocator = *allocator;
+	batch->attributes = attributes & SG_ATTRIBUTE_ALL;
+	batch->mesh.positions = NULL;
+	batch->mesh.normals = NULL;
+	batch->mesh.texcoords = NULL;
+	batch->mesh.vertices_length = 0;
+	batch->mesh.indices = NULL;
+	batch->mesh.indices_length = 0;
+	batch->vertices_capacity = 0;
+	batch->indices_capacity = 0;
+	batch->submeshes = NULL;
+	batch->submeshes_length = 0;
+	batch->submeshes_capacity = 0;
 	return SG_OK_RETURNED_BUFFER;
 }
 
 enum sg_status
-sg_cylinder_vertices(
-	struct sg_cylinder_info* cylinder,
-	size_t* length,
-	struct sg_position* positions,
-	struct sg_normal* normals,
-	struct sg_texcoord* texcoords
+sg_mesh_batch_reserve(
+	struct sg_mesh_batch* batch,
+	const size_t vertices,
+	const size_t indices,
+	const size_t submeshes
 )
 {
-	if (cylinder == NULL)
+	struct sg_mesh* mesh;
+	struct sg_allocator const* allocator;
+	size_t capacity;
+
+	if (batch == NULL)
 		return SG_ERR_INFO_NOT_PROVIDED;
 
-	if (length == NULL)
-		return SG_ERR_DSTLEN_NOT_PROVIDED;
-	
-	if (positions == NULL && normals == NULL && texcoords == NULL) {
-		*length = cylinder->subdivisions * 12;
-		return SG_OK_RETURNED_LENGTH;
-	}
-	
-	const float cylinder_top_radius = cylinder->top_radius;
-	const float cylinder_bottom_radius = cylinder->bottom_radius;
-	const float cylinder_height = cylinder->height;
-	const size_t cylinder_subdivisions = cylinder->subdivisions;
-	
-	const float sector_step = 2 * SG_PI / cylinder_subdivisions;
-	const struct sg_normal bottom_cap_normal{ 0.0f, -1.0f, 0.0f };
-	const struct sg_normal top_cap_normal{ 0.0f, 1.0f, 0.0f };
-	
-	const float z_angle = SG_ATAN2(cylinder_bottom_radius - cylinder_top_radius,
-								   cylinder_height);
-	size_t vertex_count = 0;
-	// Generate bottom cap
-	for (size_t i = 0; i < cylinder_subdivisions; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-
-		if (positions) {
-			positions[vertex_count + 0] = (struct sg_position){ 0, -(cylinder_height / 2), 0 };
-			positions[vertex_count + 1] = (struct sg_position){
-				.x = SG_COS(sector_angle) * cylinder_bottom_radius,
-				.y = -(cylinder_height / 2),
-				.z = SG_SIN(sector_angle)* cylinder_bottom_radius
-			};
-			positions[vertex_count + 2] = (struct sg_position){
-				.x = SG_COS(next_sector_angle) * cylinder_bottom_radius,
-				.y = -(cylinder_height / 2),
-				.z = SG_SIN(next_sector_angle) * cylinder_bottom_radius
-			};
-		}
+	mesh = &batch->mesh;
+	allocator = &batch->allocator;
 
-		if (normals) {
-			normals[vertex_count + 0] = bottom_cap_normal;
-			normals[vertex_count + 1] = bottom_cap_normal;
-			normals[vertex_count + 2] = bottom_cap_normal;
+	/* All buffers of a group are allocated before any is moved, so a failed
+	 * allocation leaves the batch untouched.
+	 */
+	if (mesh->vertices_length + vertices > batch->vertices_capacity) {
+		void* positions = NULL;
+		void* normals = NULL;
+		void* texcoords = NULL;
+
+		capacity = sg_grown_capacity(batch->vertices_capacity, mesh->vertices_length + vertices);
+		if (batch->attributes & SG_ATTRIBUTE_POSITION)
+			positions = allocator->alloc(capacity * sizeof(mesh->positions[0]), allocator->user);
+		if (batch->attributes & SG_ATTRIBUTE_NORMAL)
+			normals = allocator->alloc(capacity * sizeof(mesh->normals[0]), allocator->user);
+		if (batch->attributes & SG_ATTRIBUTE_TEXCOORD)
+			texcoords = allocator->alloc(capacity * sizeof(mesh->texcoords[0]), allocator->user);
+
+		if (((batch->attributes & SG_ATTRIBUTE_POSITION) && positions == NULL)
+		    || ((batch->attributes & SG_ATTRIBUTE_NORMAL) && normals == NULL)
+		    || ((batch->attributes & SG_ATTRIBUTE_TEXCOORD) && texcoords == NULL)) {
+			sg_allocator_free(allocator, positions, capacity * sizeof(mesh->positions[0]));
+			sg_allocator_free(allocator, normals, capacity * sizeof(mesh->normals[0]));
+			sg_allocator_free(allocator, texcoords, capacity * sizeof(mesh->texcoords[0]));
+			return SG_ERR_ALLOCATION_FAILED;
 		}
 
-		vertex_count += 3;
+		if (positions != NULL)
+			sg_move_buffer(allocator, (void**)&mesh->positions, positions,
+			               mesh->vertices_length * sizeof(mesh->positions[0]),
+			               batch->vertices_capacity * sizeof(mesh->positions[0]));
+		if (normals != NULL)
+			sg_move_buffer(allocator, (void**)&mesh->normals, normals,
+			               mesh->vertices_length * sizeof(mesh->normals[0]),
+			               batch->vertices_capacity * sizeof(mesh->normals[0]));
+		if (texcoords != NULL)
+			sg_move_buffer(allocator, (void**)&mesh->texcoords, texcoords,
+			               mesh->vertices_length * sizeof(mesh->texcoords[0]),
+			               batch->vertices_capacity * sizeof(mesh->texcoords[0]));
+		batch->vertices_capacity = capacity;
 	}
-	
-	// Generate top cap
-	for (size_t i = 0; i < cylinder_subdivisions; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-
-		if (positions) {
-			positions[vertex_count + 0] = (struct sg_position){ 0, cylinder_height / 2, 0 };
-			positions[vertex_count + 1] = (struct sg_position){
-				.x = SG_COS(next_sector_angle) * cylinder_top_radius,
-				.y = cylinder_height / 2,
-				.z = SG_SIN(next_sector_angle) * cylinder_top_radius
-			};
-			positions[vertex_count + 2] = (struct sg_position){
-				.x = SG_COS(sector_angle) * cylinder_top_radius,
-				.y = cylinder_height / 2,
-				.z = SG_SIN(sector_angle)* cylinder_top_radius
-			};
-		}
 
-		if (normals) {
-			normals[vertex_count + 0] = top_cap_normal;
-			normals[vertex_count + 1] = top_cap_normal;
-			normals[vertex_count + 2] = top_cap_normal;
-		}
+	if (mesh->indices_length + indices > batch->indices_capacity) {
+		void* grown;
+
+		capacity = sg_grown_capacity(batch->indices_capacity, mesh->indices_length + indices);
+		grown = allocator->alloc(capacity * sizeof(mesh->indices[0]), allocator->user);
+		if (grown == NULL)
+			return SG_ERR_ALLOCATION_FAILED;
+		sg_move_buffer(allocator, (void**)&mesh->indices, grown,
+		               mesh->indices_length * sizeof(mesh->indices[0]),
+		               batch->indices_capacity * sizeof(mesh->indices[0]));
+		batch->indices_capacity = capacity;
+	}
 
-		vertex_count += 3;
+	if (batch->submeshes_length + submeshes > batch->submeshes_capacity) {
+		void* grown;
+
+		capacity = sg_grown_capacity(batch->submeshes_capacity, batch->submeshes_length + submeshes);
+		grown = allocator->alloc(capacity * sizeof(batch->submeshes[0]), allocator->user);
+		if (grown == NULL)
+			return SG_ERR_ALLOCATION_FAILED;
+		sg_move_buffer(allocator, (void**)&batch->submeshes, grown,
+		               batch->submeshes_length * sizeof(batch->submeshes[0]),
+		               batch->submeshes_capacity * sizeof(batch->submeshes[0]));
+		batch->submeshes_capacity = capacity;
 	}
-	
-	// Generate sides
-	for (size_t i = 0; i < cylinder_subdivisions; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-
-		if (positions) {
-			struct sg_position bl{
-				.x = SG_COS(sector_angle) * cylinder_bottom_radius,
-				.y = -(cylinder_height / 2),
-				.z = SG_SIN(sector_angle)* cylinder_bottom_radius
-			};
 
-			struct sg_position br{
-				.x = SG_COS(next_sector_angle) * cylinder_bottom_radius,
-				.y = -cylinder_height / 2,
-				.z = SG_SIN(next_sector_angle)* cylinder_bottom_radius
-			};
-			struct sg_position tl{
-				.x = SG_COS(sector_angle) * cylinder_top_radius,
-				.y = cylinder_height / 2,
-				.z = SG_SIN(sector_angle) * cylinder_top_radius
-			};
-			struct sg_position tr{
-				.x = SG_COS(next_sector_angle) * cylinder_top_radius,
-				.y = cylinder_height / 2,
-				.z = SG_SIN(next_sector_angle) * cylinder_top_radius
-			};
-			
-
-			positions[vertex_count + 0] = tl;
-			positions[vertex_count + 1] = br;
-			positions[vertex_count + 2] = bl;
-			positions[vertex_count + 3] = tr;
-			positions[vertex_count + 4] = br;
-			positions[vertex_count + 5] = tl;
-		}
-		
-		if (normals) {
-			struct sg_normal left{
-				.x = SG_COS(sector_angle),
-				.y = z_angle,
-				.z = SG_SIN(sector_angle)
-			};
-			struct sg_normal right{
-				.x = SG_COS(next_sector_angle),
-				.y = z_angle,
-				.z = SG_SIN(next_sector_angle)
-			};
-			normals[vertex_count + 0] = left;
-			normals[vertex_count + 1] = right;
-			normals[vertex_count + 2] = left;
-			normals[vertex_count + 3] = right;
-			normals[vertex_count + 4] = right;
-			normals[vertex_count + 5] = left;
-		}
+	return SG_OK_RETURNED_BUFFER;
+}
 
-		vertex_count += 6;
-	}
-	
+enum sg_status
+sg_mesh_batch_clear(struct sg_mesh_batch* batch)
+{
+	if (batch == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	batch->mesh.vertices_length = 0;
+	batch->mesh.indices_length = 0;
+	batch->submeshes_length = 0;
 	return SG_OK_RETURNED_BUFFER;
 }
 
 enum sg_status
-sg_gizmo_cone_vertices(
-	struct sg_gizmo_cone_info* cone,
-	size_t* length,
-	struct sg_position* positions)
+sg_mesh_batch_free(struct sg_mesh_batch* batch)
 {
-	if (!cone) return SG_ERR_INFO_NOT_PROVIDED;
+	if (batch == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
 
-	
-	if (!positions) {
-		if (!length) return SG_ERR_DSTLEN_NOT_PROVIDED;
-		
-		*length = 12 + SG_GIZMO_CIRCLE_SUBDIVISIONS * 3;
-		return SG_OK_RETURNED_LENGTH;
-	}
-	
-	const float cone_height = cone->height;
-	const float cone_radius = cone->radius;
-	const float sector_step = 2 * SG_PI / SG_GIZMO_CIRCLE_SUBDIVISIONS;
-	
-	size_t vertex_count = 0;
-	
-		// Generate top cap
-	for (size_t i = 0; i < SG_GIZMO_CIRCLE_SUBDIVISIONS; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-
-		const struct sg_position sector_position{
-			.x = SG_COS(next_sector_angle) * cone_radius,
-			.y = -(cone_height / 2),
-			.z = SG_SIN(next_sector_angle) * cone_radius
-		};
-		const struct sg_position next_sector_position{
-			.x = SG_COS(sector_angle) * cone_radius,
-			.y = -(cone_height / 2),
-			.z = SG_SIN(sector_angle)* cone_radius
-		};
-		
-		positions[vertex_count + 0] = sector_position;
-		positions[vertex_count + 1] = next_sector_position;
-		positions[vertex_count + 2] = sector_position;
-		vertex_count += 3;
-	}
-	
-	const struct sg_position top{
-		.x = 0,
-		.y = cone_height / 2,
-		.z = 0
-	};
-	const struct sg_position left{
-		.x = cone_radius,
-		.y = -(cone_height / 2),
-		.z = 0
-	};
-	positions[vertex_count + 0] = top;
-	positions[vertex_count + 1] = left;
-	positions[vertex_count + 2] = top;
-	vertex_count += 3;
-
-	const struct sg_position right{
-		.x = -cone_radius,
-		.y = -(cone_height / 2),
-		.z = 0
-	};
-	positions[vertex_count + 0] = top;
-	positions[vertex_count + 1] = right;
-	positions[vertex_count + 2] = top;
-	vertex_count += 3;
-
-	const struct sg_position front{
-		.x = 0,
-		.y = -(cone_height / 2),
-		.z = cone_radius
-	};
-	positions[vertex_count + 0] = top;
-	positions[vertex_count + 1] = front;
-	positions[vertex_count + 2] = top;
-	vertex_count += 3;
-
-	const struct sg_position back{
-		.x = 0,
-		.y = -(cone_height / 2),
-		.z = -cone_radius
-	};
-	positions[vertex_count + 0] = top;
-	positions[vertex_count + 1] = back;
-	positions[vertex_count + 2] = top;
-	
+	/* Release the full capacities, not just the used lengths. */
+	batch->mesh.vertices_length = batch->vertices_capacity;
+	batch->mesh.indices_length = batch->indices_capacity;
+	sg_mesh_free(&batch->allocator, &batch->mesh);
+	sg_allocator_free(&batch->allocator, batch->submeshes,
+	                  batch->submeshes_capacity * sizeof(batch->submeshes[0]));
+
+	batch->vertices_capacity = 0;
+	batch->indices_capacity = 0;
+	batch->submeshes = NULL;
+	batch->submeshes_length = 0;
+	batch->submeshes_capacity = 0;
+	return SG_OK_RETURNED_BUFFER;
+}
+
+/* Reserve room for a primitive and append its submesh record, returning the
+ * streams pointing at its first vertex.
+ */
+static enum sg_status
+sg_mesh_batch_push(
+	struct sg_mesh_batch* batch,
+	const size_t vertices_length,
+	const size_t indices_length,
+	size_t* submesh,
+	struct sg_vertex_streams* streams
+)
+{
+	struct sg_submesh* record;
+	struct sg_mesh* mesh = &batch->mesh;
+	enum sg_status status;
+
+	// Rebased indices of an indexed primitive must reach its last vertex,
+	// checked before the batch grows so a rejected push changes nothing.
+	if (indices_length > 0
+	    && (mesh->vertices_length > (size_t)SG_INDICE_MAX
+	        || vertices_length - 1 > (size_t)SG_INDICE_MAX - mesh->vertices_length))
+		return SG_ERR_INVALID_RANGE;
+
+	status = sg_mesh_batch_reserve(batch, vertices_length, indices_length, 1);
+	if (!sg_success(status))
+		return status;
+
+	record = &batch->submeshes[batch->submeshes_length];
+	record->vertices_offset = mesh->vertices_length;
+	record->vertices_length = vertices_length;
+	record->indices_offset = mesh->indices_length;
+	record->indices_length = indices_length;
+
+	*streams = sg_vertex_streams_from_arrays(
+		mesh->positions ? mesh->positions + record->vertices_offset : NULL,
+		mesh->normals ? mesh->normals + record->vertices_offset : NULL,
+		mesh->texcoords ? mesh->texcoords + record->vertices_offset : NULL);
+
+	if (submesh != NULL)
+		*submesh = batch->submeshes_length;
+	batch->submeshes_length++;
+	mesh->vertices_length += vertices_length;
+	mesh->indices_length += indices_length;
 	return SG_OK_RETURNED_BUFFER;
 }
 
+static void
+sg_mesh_batch_rebase(
+	struct sg_mesh_batch* batch,
+	struct sg_submesh const* record
+)
+{
+	SG_indice* indices = batch->mesh.indices + record->indices_offset;
+	const SG_indice base = (SG_indice)record->vertices_offset;
+	size_t i;
+
+	for (i = 0; i < record->indices_length; i++)
+		indices[i] += base;
+}
+
 enum sg_status
-sg_gizmo_sphere_vertices(
-	struct sg_gizmo_sphere_info* sphere,
-	size_t* length,
-	struct sg_position* positions)
+sg_mesh_batch_add_indexed_plane(
+	struct sg_mesh_batch* batch,
+	struct sg_indexed_plane_info const* plane,
+	size_t* submesh
+)
 {
-	if (!sphere) return SG_ERR_INFO_NOT_PROVIDED;
-	
-	if (!positions) {
-		if (!length) return SG_ERR_DSTLEN_NOT_PROVIDED;
-		
-		*length = (SG_GIZMO_CIRCLE_SUBDIVISIONS * 3) * 3;
-		return SG_OK_RETURNED_LENGTH;
-	}
-	
-	const float sphere_radius = sphere->radius;
-	const float sector_step = 2 * SG_PI / SG_GIZMO_CIRCLE_SUBDIVISIONS;
-	
-	size_t vertex_count = 0;
-	
-	// Generate x band
-	for (size_t i = 0; i < SG_GIZMO_CIRCLE_SUBDIVISIONS; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-
-		const struct sg_position sector_position{
-			.x = 0,
-			.y = SG_COS(next_sector_angle) * sphere_radius,
-			.z = SG_SIN(next_sector_angle) * sphere_radius
-		};
-		const struct sg_position next_sector_position{
-			.x = 0,
-			.y = SG_COS(sector_angle) * sphere_radius,
-			.z = SG_SIN(sector_angle)* sphere_radius
-		};
-		
-		positions[vertex_count + 0] = sector_position;
-		positions[vertex_count + 1] = next_sector_position;
-		positions[vertex_count + 2] = sector_position;
-		vertex_count += 3;
-	}
-	
-	// Generate y band
-	for (size_t i = 0; i < SG_GIZMO_CIRCLE_SUBDIVISIONS; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-
-		const struct sg_position sector_position{
-			.x = SG_COS(next_sector_angle) * sphere_radius,
-			.y = 0,
-			.z = SG_SIN(next_sector_angle) * sphere_radius
-		};
-		const struct sg_position next_sector_position{
-			.x = SG_COS(sector_angle) * sphere_radius,
-			.y = 0,
-			.z = SG_SIN(sector_angle)* sphere_radius
-		};
-		
-		positions[vertex_count + 0] = sector_position;
-		positions[vertex_count + 1] = next_sector_position;
-		positions[vertex_count + 2] = sector_position;
-		vertex_count += 3;
-	}
-	
-	// Generate z band
-	for (size_t i = 0; i < SG_GIZMO_CIRCLE_SUBDIVISIONS; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-
-		const struct sg_position sector_position{
-			.x = SG_COS(next_sector_angle) * sphere_radius,
-			.y = SG_SIN(next_sector_angle) * sphere_radius,
-			.z = 0
-		};
-		const struct sg_position next_sector_position{
-			.x = SG_COS(sector_angle) * sphere_radius,
-			.y = SG_SIN(sector_angle)* sphere_radius,
-			.z = 0
-		};
-		
-		positions[vertex_count + 0] = sector_position;
-		positions[vertex_count + 1] = next_sector_position;
-		positions[vertex_count + 2] = sector_position;
-		vertex_count += 3;
-	}
+	struct sg_vertex_streams streams;
+	struct sg_submesh const* record;
+	size_t vertices_length;
+	size_t indices_length;
+	enum sg_status status;
 
+	if (batch == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	status = sg_indexed_plane_streams(plane, &vertices_length, NULL);
+	if (!sg_success(status))
+		return status;
+	status = sg_indexed_plane_indices(plane, &indices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_mesh_batch_push(batch, vertices_length, indices_length, submesh, &streams);
+	if (!sg_success(status))
+		return status;
+
+	record = &batch->submeshes[batch->submeshes_length - 1];
+	sg_indexed_plane_write(plane, &streams);
+	sg_indexed_plane_indices(plane, &indices_length,
+	                         batch->mesh.indices + record->indices_offset);
+	sg_mesh_batch_rebase(batch, record);
 	return SG_OK_RETURNED_BUFFER;
 }
 
+enum sg_status
+sg_mesh_batch_add_cube(
+	struct sg_mesh_batch* batch,
+	struct sg_cube_info* cube,
+	size_t* submesh
+)
+{
+	struct sg_vertex_streams streams;
+	size_t vertices_length;
+	enum sg_status status;
+
+	if (batch == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	status = sg_cube_streams(cube, &vertices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_mesh_batch_push(batch, vertices_length, 0, submesh, &streams);
+	if (!sg_success(status))
+		return status;
+
+	sg_cube_write(cube, &streams);
+	return SG_OK_RETURNED_BUFFER;
+}
 
 enum sg_status
-sg_gizmo_cube_vertices(
-	struct sg_gizmo_cube_info* cube,
-	size_t* length,
-	struct sg_position* positions)
+sg_mesh_batch_add_indexed_sphere(
+	struct sg_mesh_batch* batch,
+	struct sg_indexed_sphere_info* sphere,
+	size_t* submesh
+)
 {
-	if (!cube) return SG_ERR_INFO_NOT_PROVIDED;
-	
-	if (!positions) {
-		if (!length) return SG_ERR_DSTLEN_NOT_PROVIDED;
-		
-		//*length = 12 * 3;
-		*length = 12 * 3;
-		return SG_OK_RETURNED_LENGTH;
-	}
-	
-	const float cube_width = cube->width;
-	const float cube_height = cube->height;
-	const float cube_depth = cube->depth;
-	
-	const struct sg_position ftl{
-		.x = cube_width / 2,
-		.y = cube_height / 2,
-		.z = -(cube_depth / 2) 
-	};
-	const struct sg_position ftr{
-		.x = -(cube_width / 2),
-		.y = cube_height / 2,
-		.z = -(cube_depth / 2) 
-	};
-	const struct sg_position fbl{
-		.x = cube_width / 2,
-		.y = -(cube_height / 2),
-		.z = -(cube_depth / 2) 
-	};
-	const struct sg_position fbr{
-		.x = -(cube_width / 2),
-		.y = -(cube_height / 2),
-		.z = -(cube_depth / 2) 
-	};
-	const struct sg_position btl{
-		.x = cube_width / 2,
-		.y = cube_height / 2,
-		.z = cube_depth / 2 
-	};
-	const struct sg_position btr{
-		.x = -(cube_width / 2),
-		.y = cube_height / 2,
-		.z = cube_depth / 2 
-	};
-	const struct sg_position bbl{
-		.x = cube_width / 2,
-		.y = -(cube_height / 2),
-		.z = cube_depth / 2 
-	};
-	const struct sg_position bbr{
-		.x = -(cube_width / 2),
-		.y = -(cube_height / 2),
-		.z = cube_depth / 2 
-	};
+	struct sg_vertex_streams streams;
+	struct sg_submesh const* record;
+	size_t vertices_length;
+	size_t indices_length;
+	enum sg_status status;
 
-	size_t count = 0;
-	positions[count++] = ftl;
-	positions[count++] = ftr;
-	positions[count++] = ftl;
-	positions[count++] = fbl;
-	positions[count++] = fbr;
-	positions[count++] = fbl;
-
-	positions[count++] = btl;
-	positions[count++] = btr;
-	positions[count++] = btl;
-	positions[count++] = bbl;
-	positions[count++] = bbr;
-	positions[count++] = bbl;
-	
-	positions[count++] = ftl;
-	positions[count++] = btl;
-	positions[count++] = ftl;
-	positions[count++] = fbl;
-	positions[count++] = bbl;
-	positions[count++] = fbl;
-	
-	positions[count++] = ftr;
-	positions[count++] = btr;
-	positions[count++] = ftr;
-	positions[count++] = fbr;
-	positions[count++] = bbr;
-	positions[count++] = fbr;
-	
-	positions[count++] = ftr;
-	positions[count++] = fbr;
-	positions[count++] = ftr;
-	positions[count++] = btr;
-	positions[count++] = bbr;
-	positions[count++] = btr;
-
-	positions[count++] = ftl;
-	positions[count++] = fbl;
-	positions[count++] = ftl;
-	positions[count++] = btl;
-	positions[count++] = bbl;
-	positions[count++] = btl;
+	if (batch == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
 
+	status = sg_indexed_sphere_streams(sphere, &vertices_length, NULL);
+	if (!sg_success(status))
+		return status;
+	status = sg_indexed_sphere_indices(sphere, &indices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_mesh_batch_push(batch, vertices_length, indices_length, submesh, &streams);
+	if (!sg_success(status))
+		return status;
+
+	record = &batch->submeshes[batch->submeshes_length - 1];
+	sg_indexed_sphere_write(sphere, &streams);
+	sg_indexed_sphere_write_indices(sphere, batch->mesh.indices + record->indices_offset);
+	sg_mesh_batch_rebase(batch, record);
 	return SG_OK_RETURNED_BUFFER;
 }
 
 enum sg_status
-sg_gizmo_capsule_vertices(
-	struct sg_gizmo_capsule_info* capsule,
-	size_t* length,
-	struct sg_position* positions)
+sg_mesh_batch_add_cylinder(
+	struct sg_mesh_batch* batch,
+	struct sg_cylinder_info* cylinder,
+	size_t* submesh
+)
 {
-	if (!capsule) return SG_ERR_INFO_NOT_PROVIDED;
-	
-	if (!positions) {
-		if (!length) return SG_ERR_DSTLEN_NOT_PROVIDED;
-		const size_t circles_count = 4;
-		const size_t sides_count = 4;
-		*length = (SG_GIZMO_CIRCLE_SUBDIVISIONS * 3 * circles_count) + sides_count * 3;
-		return SG_OK_RETURNED_LENGTH;
-	}
-	
-	const float sector_step = 2 * SG_PI / SG_GIZMO_CIRCLE_SUBDIVISIONS;
-	const float capsule_diameter = capsule->diameter;
-	const float radius = capsule_diameter / 2;
-	const float capsule_height = (capsule->height < radius) ? radius : capsule->height;
-	
-	size_t vertex_count = 0;
-	
-	// Generate top x band
-	
-	const size_t gizmo_half_circle = SG_GIZMO_CIRCLE_SUBDIVISIONS / 2;
-	const size_t gizmo_quarter_circle = SG_GIZMO_CIRCLE_SUBDIVISIONS / 4;
-	
-	const size_t top_x_start = gizmo_half_circle + gizmo_quarter_circle;
-	const size_t top_x_stop = SG_GIZMO_CIRCLE_SUBDIVISIONS + gizmo_quarter_circle;
-	for (size_t i = top_x_start; i < top_x_stop; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-		const float offset = capsule_height/2 - radius;
-
-		const struct sg_position position{
-			.x = 0,
-			.y = offset + SG_COS(sector_angle) * radius,
-			.z = SG_SIN(sector_angle) * radius
-		};
-		const struct sg_position next_position{
-			.x = 0,
-			.y = offset + SG_COS(next_sector_angle) * radius,
-			.z = SG_SIN(next_sector_angle) * radius
-		};
-		
-		positions[vertex_count + 0] = position;
-		positions[vertex_count + 1] = next_position;
-		positions[vertex_count + 2] = position;
-		vertex_count += 3;
-	}
-	
-	// Generate top y band
-	const size_t top_y_start = gizmo_half_circle + gizmo_quarter_circle;
-	const size_t top_y_stop = SG_GIZMO_CIRCLE_SUBDIVISIONS + gizmo_quarter_circle;
-	for (size_t i = top_y_start; i < top_y_stop; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-		const float offset = capsule_height/2 - radius;
-
-		const struct sg_position position{
-			.x = SG_SIN(sector_angle) * radius,
-			.y = offset + SG_COS(sector_angle) * radius,
-			.z = 0 
-		};
-		const struct sg_position next_position{
-			.x = SG_SIN(next_sector_angle) * radius,
-			.y = offset + SG_COS(next_sector_angle) * radius,
-			.z = 0 
-		};
-		
-		positions[vertex_count + 0] = position;
-		positions[vertex_count + 1] = next_position;
-		positions[vertex_count + 2] = position;
-		vertex_count += 3;
-	}
-	
-	
-	// Generate top y band
-	for (size_t i = 0; i < SG_GIZMO_CIRCLE_SUBDIVISIONS; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-
-		const struct sg_position position{
-			.x = SG_COS(sector_angle) * radius,
-			.y = capsule_height/2 - radius,
-			.z = SG_SIN(sector_angle) * radius
-		};
-		const struct sg_position next_position{
-			.x = SG_COS(next_sector_angle) * radius,
-			.y = capsule_height/2 - radius,
-			.z = SG_SIN(next_sector_angle)* radius
-		};
-		
-		positions[vertex_count + 0] = position;
-		positions[vertex_count + 1] = next_position;
-		positions[vertex_count + 2] = position;
-		vertex_count += 3;
-	}
-	
-	// Generate bot x band
-	const size_t bot_x_start = SG_GIZMO_CIRCLE_SUBDIVISIONS / 4;
-	const size_t bot_x_stop = bot_x_start + SG_GIZMO_CIRCLE_SUBDIVISIONS / 2;
-	for (size_t i = bot_x_start; i < bot_x_stop; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-		const float offset = -(capsule_height/2 - radius);
-
-		const struct sg_position position{
-			.x = 0,
-			.y = offset + SG_COS(sector_angle) * radius,
-			.z = SG_SIN(sector_angle) * radius
-		};
-		const struct sg_position next_position{
-			.x = 0,
-			.y = offset + SG_COS(next_sector_angle) * radius,
-			.z = SG_SIN(next_sector_angle) * radius
-		};
-		
-		positions[vertex_count + 0] = position;
-		positions[vertex_count + 1] = next_position;
-		positions[vertex_count + 2] = position;
-		vertex_count += 3;
-	}
-	
-	// Generate bot y band
-	const size_t bot_y_start = SG_GIZMO_CIRCLE_SUBDIVISIONS / 4;
-	const size_t bot_y_stop = bot_y_start + SG_GIZMO_CIRCLE_SUBDIVISIONS / 2;
-	for (size_t i = bot_y_start; i < bot_y_stop; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-		const float offset = -(capsule_height/2 - radius);
-
-		const struct sg_position position{
-			.x = SG_SIN(sector_angle) * radius,
-			.y = offset + SG_COS(sector_angle) * radius,
-			.z = 0 
-		};
-		const struct sg_position next_position{
-			.x = SG_SIN(next_sector_angle) * radius,
-			.y = offset + SG_COS(next_sector_angle) * radius,
-			.z = 0 
-		};
-		
-		positions[vertex_count + 0] = position;
-		positions[vertex_count + 1] = next_position;
-		positions[vertex_count + 2] = position;
-		vertex_count += 3;
-	}
-	
-	// Generate bottom band
-	for (size_t i = 0; i < SG_GIZMO_CIRCLE_SUBDIVISIONS; i++) {
-		const float sector_angle = i * sector_step;
-		const float next_sector_angle = (i+1) * sector_step;
-
-		const struct sg_position position{
-			.x = SG_COS(sector_angle) * radius,
-			.y = -(capsule_height/2 - radius),
-			.z = SG_SIN(sector_angle) * radius
-		};
-		const struct sg_position next_position{
-			.x = SG_COS(next_sector_angle) * radius,
-			.y = -(capsule_height/2 - radius),
-			.z = SG_SIN(next_sector_angle)* radius
-		};
-		
-		positions[vertex_count + 0] = position;
-		positions[vertex_count + 1] = next_position;
-		positions[vertex_count + 2] = position;
-		vertex_count += 3;
-	}
-	
-	const float side_top = (capsule_height/2 - radius);
-	const float side_bot = -(capsule_height/2 - radius);
-	
-	const struct sg_position front_bot{
-		.x = 0,
-		.y = side_bot,
-		.z = radius
-	};
-	const struct sg_position front_top{
-		.x = 0,
-		.y = side_top,
-		.z = radius
-	};
-	positions[vertex_count + 0] = front_bot;
-	positions[vertex_count + 1] = front_top;
-	positions[vertex_count + 2] = front_bot;
-	vertex_count += 3;
-
-	const struct sg_position back_bot{
-		.x = 0,
-		.y = side_bot,
-		.z = -radius
-	};
-	const struct sg_position back_top{
-		.x = 0,
-		.y = side_top,
-		.z = -radius
-	};
-	positions[vertex_count + 0] = back_bot;
-	positions[vertex_count + 1] = back_top;
-	positions[vertex_count + 2] = back_bot;
-	vertex_count += 3;
-	
-	const struct sg_position left_bot{
-		.x = -radius,
-		.y = side_bot,
-		.z = 0
-	};
-	const struct sg_position left_top{
-		.x = -radius,
-		.y = side_top,
-		.z = 0
-	};
-	positions[vertex_count + 0] = left_bot;
-	positions[vertex_count + 1] = left_top;
-	positions[vertex_count + 2] = left_bot;
-	vertex_count += 3;
-
-	const struct sg_position right_bot{
-		.x = radius,
-		.y = side_bot,
-		.z = 0
-	};
-	const struct sg_position right_top{
-		.x = radius,
-		.y = side_top,
-		.z = 0
-	};
-	positions[vertex_count + 0] = right_bot;
-	positions[vertex_count + 1] = right_top;
-	positions[vertex_count + 2] = right_bot;
+	struct sg_vertex_streams streams;
+	size_t vertices_length;
+	enum sg_status status;
+
+	if (batch == NULL)
+		return SG_ERR_INFO_NOT_PROVIDED;
+
+	status = sg_cylinder_streams(cylinder, &vertices_length, NULL);
+	if (!sg_success(status))
+		return status;
+
+	status = sg_mesh_batch_push(batch, vertices_length, 0, submesh, &streams);
+	if (!sg_success(status))
+		return status;
+
+	sg_cylinder_write(cylinder, &streams);
 	return SG_OK_RETURNED_BUFFER;
 }
 
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+/* Best of 'repeats' runs of 'function', in milliseconds. */
+template<typename Function>
+double benchmark_ms(const int repeats, Function function)
+{
+	double best = 0.0;
+	for (int i = 0; i < repeats; i++) {
+		const auto start = std::chrono::steady_clock::now();
+		function();
+		const auto stop = std::chrono::steady_clock::now();
+		const double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+		if (i == 0 || ms < best)
+			best = ms;
+	}
+	return best;
+}
+
+/* Keep the compiler from discarding the work behind 'value'. */
+template<typename T>
+void benchmark_keep(T const& value)
+{
+	asm volatile("" : : "g"(&value) : "memory");
+}
@@ -0,0 +1,82 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "benchmark.hpp"
+
+#include <cstring>
+
+/* Calls per second of sg_cube_vertices() writing positions, normals &
+ * texcoords, against building the three tables on the stack every call and
+ * storing them vertex by vertex.
+ */
+
+static void
+cube_stack_tables(
+	sg_cube_info const& cube,
+	sg_position* positions,
+	sg_normal* normals,
+	sg_texcoord* texcoords
+)
+{
+	const sg_vertex_streams streams = sg_vertex_streams_from_arrays(positions, normals, texcoords);
+	sg_position cube_positions[36];
+	sg_normal cube_normals[36];
+	sg_texcoord cube_texcoords[36];
+
+	for (size_t i = 0; i < 36; i++) {
+		cube_positions[i] = {
+			sg_cube_unit_positions[i].x * cube.width,
+			sg_cube_unit_positions[i].y * cube.height,
+			sg_cube_unit_positions[i].z * cube.depth
+		};
+		cube_normals[i] = sg_cube_normals[i];
+		cube_texcoords[i] = sg_cube_texcoords[i];
+	}
+	benchmark_keep(cube_normals);
+	benchmark_keep(cube_texcoords);
+
+	for (size_t i = 0; i < 36; i++)
+		sg_store_normal(&streams, i, cube_normals[i]);
+	for (size_t i = 0; i < 36; i++)
+		sg_store_position(&streams, i, cube_positions[i]);
+	for (size_t i = 0; i < 36; i++)
+		sg_store_texcoord(&streams, i, cube_texcoords[i]);
+}
+
+int main()
+{
+	const size_t calls = 1 << 20;
+	const int repeats = 10;
+	sg_cube_info cube{ 1.0f, 2.0f, 3.0f };
+	sg_position positions[36];
+	sg_normal normals[36];
+	sg_texcoord texcoords[36];
+	sg_position expected_positions[36];
+	sg_normal expected_normals[36];
+	sg_texcoord expected_texcoords[36];
+
+	const double stack_ms = benchmark_ms(repeats, [&]() {
+		for (size_t i = 0; i < calls; i++) {
+			cube_stack_tables(cube, expected_positions, expected_normals, expected_texcoords);
+			benchmark_keep(expected_positions);
+		}
+	});
+
+	const double generator_ms = benchmark_ms(repeats, [&]() {
+		for (size_t i = 0; i < calls; i++) {
+			size_t length = 36;
+			sg_cube_vertices(&cube, &length, positions, normals, texcoords);
+			benchmark_keep(positions);
+		}
+	});
+
+	if (memcmp(expected_positions, positions, sizeof(positions)) != 0
+	    || memcmp(expected_normals, normals, sizeof(normals)) != 0
+	    || memcmp(expected_texcoords, texcoords, sizeof(texcoords)) != 0) {
+		printf("sg_cube_vertices and the stack tables disagree\n");
+		return 1;
+	}
+
+	printf("%22s %22s\n", "stack tables (M/s)", "generator (M/s)");
+	printf("%22.1f %22.1f\n", calls / (stack_ms * 1e3), calls / (generator_ms * 1e3));
+	return 0;
+}
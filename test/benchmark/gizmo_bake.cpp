@@ -0,0 +1,94 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "benchmark.hpp"
+
+#include <vector>
+
+/* Place 1000 line list gizmo spheres per frame, once regenerating every
+ * sphere, once baking cached unit spheres with a scalar loop and once with
+ * sg_gizmo_cache_bake().
+ */
+
+static void
+bake_scalar(
+	sg_mesh const& gizmo,
+	std::vector<sg_gizmo_instance> const& instances,
+	sg_position* positions
+)
+{
+	for (size_t i = 0; i < instances.size(); i++) {
+		sg_gizmo_instance const& instance = instances[i];
+		sg_position* dst = positions + i * gizmo.vertices_length;
+		for (size_t j = 0; j < gizmo.vertices_length; j++) {
+			const sg_position src = gizmo.positions[j];
+			dst[j].x = instance.center.x + src.x * instance.scale.x;
+			dst[j].y = (instance.center.y + src.y * instance.scale.y)
+			         + ((src.y < 0.0f) ? -instance.stretch : instance.stretch);
+			dst[j].z = instance.center.z + src.z * instance.scale.z;
+		}
+	}
+}
+
+int main()
+{
+	const size_t count = 1000;
+	const int repeats = 50;
+	const sg_allocator allocator = sg_default_allocator();
+
+	sg_gizmo_cache cache;
+	if (!sg_success(sg_gizmo_cache_init(&cache, SG_GIZMO_TOPOLOGY_LINE_LIST, 0, &allocator))) {
+		printf("could not initialize the gizmo cache\n");
+		return 1;
+	}
+	sg_mesh const& gizmo = cache.templates[SG_GIZMO_SHAPE_SPHERE];
+
+	std::vector<sg_gizmo_sphere_info> spheres(count);
+	std::vector<sg_vec3f> centers(count);
+	std::vector<sg_gizmo_instance> instances(count);
+	for (size_t i = 0; i < count; i++) {
+		spheres[i] = { 0.5f + (i % 7) * 0.25f, SG_GIZMO_TOPOLOGY_LINE_LIST, 0 };
+		centers[i] = { (float)(i % 10), (float)(i / 100), (float)(i % 100 / 10) };
+		instances[i] = sg_gizmo_sphere_instance(&spheres[i], centers[i], 0xffffffffu);
+	}
+
+	const size_t length = gizmo.vertices_length * count;
+	std::vector<sg_position> positions(length);
+	std::vector<sg_position> expected(length);
+
+	const double regenerate_ms = benchmark_ms(repeats, [&]() {
+		for (size_t i = 0; i < count; i++) {
+			sg_position* dst = positions.data() + i * gizmo.vertices_length;
+			size_t sphere_length = gizmo.vertices_length;
+			sg_gizmo_sphere_vertices(&spheres[i], &sphere_length, dst);
+			for (size_t j = 0; j < sphere_length; j++) {
+				dst[j].x += centers[i].x;
+				dst[j].y += centers[i].y;
+				dst[j].z += centers[i].z;
+			}
+		}
+		benchmark_keep(positions[length - 1]);
+	});
+
+	const double scalar_ms = benchmark_ms(repeats, [&]() {
+		bake_scalar(gizmo, instances, expected.data());
+		benchmark_keep(expected[length - 1]);
+	});
+
+	const double bake_ms = benchmark_ms(repeats, [&]() {
+		size_t bake_length = length;
+		sg_gizmo_cache_bake(&cache, SG_GIZMO_SHAPE_SPHERE, instances.data(), count, &bake_length, positions.data());
+		benchmark_keep(positions[length - 1]);
+	});
+
+	for (size_t j = 0; j < length; j++) {
+		if (positions[j].x != expected[j].x || positions[j].y != expected[j].y || positions[j].z != expected[j].z) {
+			printf("sg_gizmo_cache_bake and the scalar loop disagree\n");
+			return 1;
+		}
+	}
+
+	printf("%10s %18s %18s %18s\n", "vertices", "regenerate (ms)", "bake scalar (ms)", "bake (ms)");
+	printf("%10zu %18.3f %18.3f %18.3f\n", length, regenerate_ms, scalar_ms, bake_ms);
+	sg_gizmo_cache_free(&cache);
+	return 0;
+}
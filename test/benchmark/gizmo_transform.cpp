@@ -0,0 +1,120 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "benchmark.hpp"
+
+#include <cmath>
+#include <vector>
+
+/* Place 1000 rotated line list gizmo capsules per frame:
+ *  - generating every capsule, then transforming it in a second pass,
+ *  - generating every capsule through its transform, fused,
+ *  - baking cached unit capsules through their transforms with a scalar loop,
+ *  - baking them with sg_gizmo_cache_bake_transformed().
+ * validation_gizmo_transform checks that the results agree.
+ */
+
+static sg_position
+transform_point(sg_mat3x4 const& m, sg_position const& p)
+{
+	return {
+		m.m[0][0] * p.x + m.m[0][1] * p.y + m.m[0][2] * p.z + m.m[0][3],
+		m.m[1][0] * p.x + m.m[1][1] * p.y + m.m[1][2] * p.z + m.m[1][3],
+		m.m[2][0] * p.x + m.m[2][1] * p.y + m.m[2][2] * p.z + m.m[2][3],
+	};
+}
+
+static void
+bake_scalar(
+	sg_mesh const& gizmo,
+	std::vector<sg_gizmo_instance> const& instances,
+	std::vector<sg_mat3x4> const& transforms,
+	sg_position* positions
+)
+{
+	for (size_t i = 0; i < instances.size(); i++) {
+		sg_gizmo_instance const& instance = instances[i];
+		sg_mat3x4 const& m = transforms[i];
+		sg_position* dst = positions + i * gizmo.vertices_length;
+		for (size_t j = 0; j < gizmo.vertices_length; j++) {
+			const sg_position src = gizmo.positions[j];
+			const float stretch = (src.y < 0.0f) ? -instance.stretch : instance.stretch;
+			const sg_position placed = {
+				instance.center.x + src.x * instance.scale.x,
+				instance.center.y + src.y * instance.scale.y + stretch,
+				instance.center.z + src.z * instance.scale.z,
+			};
+			dst[j] = transform_point(m, placed);
+		}
+	}
+}
+
+int main()
+{
+	const size_t count = 1000;
+	const int repeats = 20;
+	const sg_allocator allocator = sg_default_allocator();
+
+	sg_gizmo_cache cache;
+	if (!sg_success(sg_gizmo_cache_init(&cache, SG_GIZMO_TOPOLOGY_LINE_LIST, 0, &allocator))) {
+		printf("could not initialize the gizmo cache\n");
+		return 1;
+	}
+	sg_mesh const& gizmo = cache.templates[SG_GIZMO_SHAPE_CAPSULE];
+
+	std::vector<sg_gizmo_capsule_info> capsules(count);
+	std::vector<sg_gizmo_instance> instances(count);
+	std::vector<sg_mat3x4> transforms(count);
+	for (size_t i = 0; i < count; i++) {
+		const float angle = i * 0.01f;
+		const sg_quatf rotation = { 0.0f, sinf(angle), 0.0f, cosf(angle) };
+		const sg_vec3f translation = { (float)(i % 10), (float)(i / 100), (float)(i % 100 / 10) };
+		capsules[i] = { 1.0f + (i % 5) * 0.5f, 0.5f + (i % 3) * 0.25f, SG_GIZMO_TOPOLOGY_LINE_LIST, 0 };
+		instances[i] = sg_gizmo_capsule_instance(&capsules[i], { 0.0f, 0.0f, 0.0f }, 0xffffffffu);
+		transforms[i] = sg_mat3x4_from_trs(translation, rotation, { 1.0f, 1.0f, 1.0f });
+	}
+
+	size_t capsule_length = 0;
+	sg_gizmo_capsule_vertices(&capsules[0], &capsule_length, NULL);
+	const size_t length = capsule_length * count;
+	std::vector<sg_position> two_pass(length);
+	std::vector<sg_position> fused(length);
+	std::vector<sg_position> scalar(gizmo.vertices_length * count);
+	std::vector<sg_position> baked(gizmo.vertices_length * count);
+
+	const double two_pass_ms = benchmark_ms(repeats, [&]() {
+		for (size_t i = 0; i < count; i++) {
+			sg_position* dst = two_pass.data() + i * capsule_length;
+			size_t vertices_length = capsule_length;
+			sg_gizmo_capsule_vertices(&capsules[i], &vertices_length, dst);
+			for (size_t j = 0; j < vertices_length; j++)
+				dst[j] = transform_point(transforms[i], dst[j]);
+		}
+		benchmark_keep(two_pass[length - 1]);
+	});
+
+	const double fused_ms = benchmark_ms(repeats, [&]() {
+		for (size_t i = 0; i < count; i++) {
+			size_t vertices_length = capsule_length;
+			sg_gizmo_capsule_vertices_transformed(&capsules[i], &transforms[i], &vertices_length,
+			                                      fused.data() + i * capsule_length);
+		}
+		benchmark_keep(fused[length - 1]);
+	});
+
+	const double scalar_ms = benchmark_ms(repeats, [&]() {
+		bake_scalar(gizmo, instances, transforms, scalar.data());
+		benchmark_keep(scalar[scalar.size() - 1]);
+	});
+
+	const double bake_ms = benchmark_ms(repeats, [&]() {
+		size_t bake_length = baked.size();
+		sg_gizmo_cache_bake_transformed(&cache, SG_GIZMO_SHAPE_CAPSULE, instances.data(), transforms.data(),
+		                                count, &bake_length, baked.data());
+		benchmark_keep(baked[baked.size() - 1]);
+	});
+
+	printf("%10s %22s %14s %18s %14s\n", "vertices", "generate + pass (ms)", "fused (ms)", "bake scalar (ms)", "bake (ms)");
+	printf("%10zu %22.3f %14.3f %18.3f %14.3f\n", length, two_pass_ms, fused_ms, scalar_ms, bake_ms);
+	sg_gizmo_cache_free(&cache);
+	return 0;
+}
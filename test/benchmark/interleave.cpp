@@ -0,0 +1,73 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "benchmark.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+/* Interleave positions, normals & texcoords into an AoS buffer, once with a
+ * sg_strided_blockcopy() per attribute and once with a single sg_interleave().
+ */
+
+struct Vertex {
+	sg_position position;
+	sg_normal normal;
+	sg_texcoord texcoord;
+};
+
+int main()
+{
+	const size_t lengths[] = { 1 << 10, 1 << 16, 1 << 20, 1 << 22 };
+
+	printf("%10s %16s %16s\n", "vertices", "blockcopy (ms)", "interleave (ms)");
+	for (const size_t length : lengths) {
+		std::vector<sg_position> positions(length);
+		std::vector<sg_normal> normals(length);
+		std::vector<sg_texcoord> texcoords(length);
+		std::vector<Vertex> vertices(length);
+		for (size_t i = 0; i < length; i++) {
+			positions[i] = { (float)i, 1.0f, 2.0f };
+			normals[i] = { 0.0f, 1.0f, 0.0f };
+			texcoords[i] = { 0.5f, (float)i };
+		}
+		const int repeats = (length < (1 << 20)) ? 200 : 10;
+
+		const double blockcopy_ms = benchmark_ms(repeats, [&]() {
+			sg_strided_blockcopy_source_info source;
+			source.block_count = length;
+
+			source.ptr = positions.data();
+			source.block_size = source.stride = sizeof(positions[0]);
+			sg_strided_blockcopy(&source, sizeof(Vertex), (char*)vertices.data() + offsetof(Vertex, position));
+
+			source.ptr = normals.data();
+			source.block_size = source.stride = sizeof(normals[0]);
+			sg_strided_blockcopy(&source, sizeof(Vertex), (char*)vertices.data() + offsetof(Vertex, normal));
+
+			source.ptr = texcoords.data();
+			source.block_size = source.stride = sizeof(texcoords[0]);
+			sg_strided_blockcopy(&source, sizeof(Vertex), (char*)vertices.data() + offsetof(Vertex, texcoord));
+			benchmark_keep(vertices[length - 1]);
+		});
+
+		const std::vector<Vertex> expected = vertices;
+
+		const double interleave_ms = benchmark_ms(repeats, [&]() {
+			const sg_interleave_source_info sources[3] = {
+				{ positions.data(), sizeof(positions[0]), sizeof(positions[0]), offsetof(Vertex, position) },
+				{ normals.data(), sizeof(normals[0]), sizeof(normals[0]), offsetof(Vertex, normal) },
+				{ texcoords.data(), sizeof(texcoords[0]), sizeof(texcoords[0]), offsetof(Vertex, texcoord) },
+			};
+			sg_interleave(sources, 3, length, sizeof(Vertex), vertices.data());
+			benchmark_keep(vertices[length - 1]);
+		});
+
+		if (memcmp(expected.data(), vertices.data(), length * sizeof(Vertex)) != 0) {
+			printf("sg_interleave and sg_strided_blockcopy disagree\n");
+			return 1;
+		}
+		printf("%10zu %16.3f %16.3f\n", length, blockcopy_ms, interleave_ms);
+	}
+	return 0;
+}
@@ -0,0 +1,83 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "benchmark.hpp"
+
+#include <cstring>
+#include <vector>
+
+/* Generate the positions, normals & texcoords of a 4096x4096 indexed plane,
+ * once writing each stream in its own sweep and once with
+ * sg_indexed_plane_vertices(), which writes every stream of a row in a
+ * single pass.
+ */
+
+static void
+plane_per_stream(
+	sg_indexed_plane_info const& plane,
+	sg_position* positions,
+	sg_normal* normals,
+	sg_texcoord* texcoords
+)
+{
+	const float width_scale = plane.width / (plane.width_subdivisions - 1);
+	const float depth_scale = plane.depth / (plane.depth_subdivisions - 1);
+	const float u_scale = 1.0f / (plane.width_subdivisions - 1);
+	const float v_scale = 1.0f / (plane.depth_subdivisions - 1);
+	size_t n;
+
+	n = 0;
+	for (size_t d = 0; d < plane.depth_subdivisions; d++)
+		for (size_t w = 0; w < plane.width_subdivisions; w++)
+			positions[n++] = { width_scale * w, depth_scale * d, 0.0f };
+
+	n = 0;
+	for (size_t d = 0; d < plane.depth_subdivisions; d++)
+		for (size_t w = 0; w < plane.width_subdivisions; w++)
+			normals[n++] = { 0.0f, 0.0f, 1.0f };
+
+	n = 0;
+	for (size_t d = 0; d < plane.depth_subdivisions; d++)
+		for (size_t w = 0; w < plane.width_subdivisions; w++)
+			texcoords[n++] = { u_scale * w, v_scale * d };
+}
+
+int main()
+{
+	sg_indexed_plane_info plane{};
+	plane.width = 4.0f;
+	plane.depth = 4.0f;
+	plane.width_subdivisions = 4096;
+	plane.depth_subdivisions = 4096;
+
+	size_t length = 0;
+	sg_indexed_plane_vertices(&plane, &length, NULL, NULL, NULL);
+
+	std::vector<sg_position> positions(length);
+	std::vector<sg_normal> normals(length);
+	std::vector<sg_texcoord> texcoords(length);
+	const int repeats = 10;
+
+	const double per_stream_ms = benchmark_ms(repeats, [&]() {
+		plane_per_stream(plane, positions.data(), normals.data(), texcoords.data());
+		benchmark_keep(texcoords[length - 1]);
+	});
+
+	const std::vector<sg_position> expected_positions = positions;
+	const std::vector<sg_texcoord> expected_texcoords = texcoords;
+
+	const double generator_ms = benchmark_ms(repeats, [&]() {
+		sg_indexed_plane_vertices(&plane, &length, positions.data(), normals.data(), texcoords.data());
+		benchmark_keep(texcoords[length - 1]);
+	});
+
+	if (memcmp(expected_positions.data(), positions.data(), length * sizeof(sg_position)) != 0
+	    || memcmp(expected_texcoords.data(), texcoords.data(), length * sizeof(sg_texcoord)) != 0) {
+		printf("sg_indexed_plane_vertices and the per stream sweeps disagree\n");
+		return 1;
+	}
+
+	printf("%10s %16s %16s\n", "grid", "per stream (ms)", "generator (ms)");
+	printf("%4zux%-5zu %16.3f %16.3f\n", plane.width_subdivisions, plane.depth_subdivisions,
+	       per_stream_ms, generator_ms);
+	return 0;
+}
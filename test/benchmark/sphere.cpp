@@ -0,0 +1,61 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "benchmark.hpp"
+
+#include <vector>
+
+/* Generate the positions, normals & texcoords of an indexed sphere, once with
+ * trig evaluated for every vertex and once with sg_indexed_sphere_vertices().
+ */
+
+static void
+sphere_per_vertex(
+	sg_indexed_sphere_info const& info,
+	sg_position* positions,
+	sg_normal* normals,
+	sg_texcoord* texcoords
+)
+{
+	size_t n = 0;
+	for (size_t i = 0; i <= info.stacks; ++i) {
+		const float v = i / (float)info.stacks;
+		const float phi = v * SG_PI;
+		for (size_t j = 0; j <= info.slices; ++j, ++n) {
+			const float u = j / (float)info.slices;
+			const float theta = u * SG_2PI;
+			normals[n] = { SG_COS(theta) * SG_SIN(phi), SG_COS(phi), SG_SIN(theta) * SG_SIN(phi) };
+			positions[n] = { normals[n].x * info.radius, normals[n].y * info.radius, normals[n].z * info.radius };
+			texcoords[n] = { u, v };
+		}
+	}
+}
+
+int main()
+{
+	const size_t grids[] = { 512, 2048 };
+
+	printf("%10s %16s %16s\n", "grid", "per vertex (ms)", "generator (ms)");
+	for (const size_t grid : grids) {
+		sg_indexed_sphere_info info{ 1.0f, grid, grid };
+		size_t length = 0;
+		sg_indexed_sphere_vertices(&info, &length, NULL, NULL, NULL);
+
+		std::vector<sg_position> positions(length);
+		std::vector<sg_normal> normals(length);
+		std::vector<sg_texcoord> texcoords(length);
+		const int repeats = (grid < 2048) ? 50 : 5;
+
+		const double per_vertex_ms = benchmark_ms(repeats, [&]() {
+			sphere_per_vertex(info, positions.data(), normals.data(), texcoords.data());
+			benchmark_keep(positions[length - 1]);
+		});
+
+		const double generator_ms = benchmark_ms(repeats, [&]() {
+			sg_indexed_sphere_vertices(&info, &length, positions.data(), normals.data(), texcoords.data());
+			benchmark_keep(positions[length - 1]);
+		});
+
+		printf("%4zux%-5zu %16.3f %16.3f\n", grid, grid, per_vertex_ms, generator_ms);
+	}
+	return 0;
+}
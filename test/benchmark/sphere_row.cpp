@@ -0,0 +1,78 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "benchmark.hpp"
+
+#include <vector>
+
+/* Scale a row of slice tables into normals & positions, once with the plain
+ * scalar loop and once with sg_indexed_sphere_row_kernel(), in the row tiles
+ * sg_indexed_sphere_vertices() uses.
+ */
+
+static void
+sphere_row_scalar(
+	const float* slice_cos,
+	const float* slice_sin,
+	const size_t count,
+	const float sin_phi,
+	const float radius,
+	float* normals_x,
+	float* normals_z,
+	float* positions_x,
+	float* positions_z
+)
+{
+	for (size_t j = 0; j < count; j++) {
+		normals_x[j] = slice_cos[j] * sin_phi;
+		normals_z[j] = slice_sin[j] * sin_phi;
+		positions_x[j] = normals_x[j] * radius;
+		positions_z[j] = normals_z[j] * radius;
+	}
+}
+
+template<typename Kernel>
+static void
+sphere_rows(const size_t rows, std::vector<float> const& slice_cos, std::vector<float> const& slice_sin, Kernel kernel)
+{
+	float normals_x[SG_SPHERE_ROW_TILE];
+	float normals_z[SG_SPHERE_ROW_TILE];
+	float positions_x[SG_SPHERE_ROW_TILE];
+	float positions_z[SG_SPHERE_ROW_TILE];
+	const size_t span = slice_cos.size();
+
+	for (size_t i = 0; i < rows; i++) {
+		const float sin_phi = SG_SIN(i / (float)rows * SG_PI);
+		for (size_t j = 0; j < span; j += SG_SPHERE_ROW_TILE) {
+			const size_t count = (span - j < SG_SPHERE_ROW_TILE) ? span - j : SG_SPHERE_ROW_TILE;
+			kernel(slice_cos.data() + j, slice_sin.data() + j, count, sin_phi, 2.0f,
+			       normals_x, normals_z, positions_x, positions_z);
+			benchmark_keep(positions_z);
+		}
+	}
+}
+
+int main()
+{
+	const size_t grids[] = { 512, 2048 };
+
+	printf("%10s %16s %16s\n", "grid", "scalar (ms)", "kernel (ms)");
+	for (const size_t grid : grids) {
+		std::vector<float> slice_cos(grid + 1);
+		std::vector<float> slice_sin(grid + 1);
+		for (size_t j = 0; j <= grid; j++) {
+			slice_cos[j] = SG_COS(j * (SG_2PI / grid));
+			slice_sin[j] = SG_SIN(j * (SG_2PI / grid));
+		}
+		const int repeats = (grid < 2048) ? 200 : 20;
+
+		const double scalar_ms = benchmark_ms(repeats, [&]() {
+			sphere_rows(grid + 1, slice_cos, slice_sin, sphere_row_scalar);
+		});
+		const double kernel_ms = benchmark_ms(repeats, [&]() {
+			sphere_rows(grid + 1, slice_cos, slice_sin, sg_indexed_sphere_row_kernel);
+		});
+
+		printf("%4zux%-5zu %16.3f %16.3f\n", grid, grid, scalar_ms, kernel_ms);
+	}
+	return 0;
+}
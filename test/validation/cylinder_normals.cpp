@@ -0,0 +1,58 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <cmath>
+#include <vector>
+
+/* Every normal of a cylinder, indexed or not, has unit length, including
+ * tapered, inverted & pointed cylinders and cylinders with several stacks.
+ */
+
+static bool
+normals_unit_length(std::vector<sg_normal> const& normals)
+{
+	for (sg_normal const& normal : normals) {
+		const float length = sqrtf(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+		if (!(fabsf(length - 1.0f) < 1e-5f))
+			return false;
+	}
+	return true;
+}
+
+void test_cylinder_normals()
+{
+	sg_cylinder_info cylinders[] = {
+		{ 2.0f, 1.0f, 1.0f, 12, 1 },   // straight
+		{ 2.0f, 0.5f, 1.0f, 12, 1 },   // tapered
+		{ 2.0f, 1.5f, 0.25f, 12, 1 },  // inverted, wider at the top
+		{ 1.0f, 0.0f, 1.0f, 16, 1 },   // cone, pointed top
+		{ 1.0f, 1.0f, 0.0f, 16, 1 },   // pointed bottom
+		{ 3.0f, 0.25f, 2.0f, 7, 5 },   // tapered, several stacks
+		{ 3.0f, 2.0f, 0.0f, 100, 8 },  // inverted cone, several stacks
+		{ 0.0f, 1.0f, 2.0f, 12, 3 },   // flat
+	};
+
+	for (sg_cylinder_info& cylinder : cylinders) {
+		size_t length = 0;
+		CHECK(sg_cylinder_vertices(&cylinder, &length, NULL, NULL, NULL) == SG_OK_RETURNED_LENGTH,
+		      "could not query cylinder length");
+		std::vector<sg_normal> normals(length);
+		CHECK(sg_success(sg_cylinder_vertices(&cylinder, &length, NULL, normals.data(), NULL)),
+		      "could not generate cylinder");
+		CHECK(normals_unit_length(normals), "cylinder normal is not unit length");
+
+		CHECK(sg_indexed_cylinder_vertices(&cylinder, &length, NULL, NULL, NULL) == SG_OK_RETURNED_LENGTH,
+		      "could not query indexed cylinder length");
+		normals.resize(length);
+		CHECK(sg_success(sg_indexed_cylinder_vertices(&cylinder, &length, NULL, normals.data(), NULL)),
+		      "could not generate indexed cylinder");
+		CHECK(normals_unit_length(normals), "indexed cylinder normal is not unit length");
+	}
+}
+
+int main()
+{
+	test_cylinder_normals();
+	return 0;
+}
@@ -0,0 +1,172 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/* The debug draw accumulator double buffers its frames, drops or rejects
+ * requests that do not fit whole, and draws gizmos like the transformed
+ * gizmo generators.
+ */
+
+static const sg_allocator allocator = sg_default_allocator();
+static const size_t subdivisions = 16;
+
+static bool
+positions_close(sg_position const* a, sg_position const* b, const size_t length)
+{
+	for (size_t j = 0; j < length; j++) {
+		if (fabsf(a[j].x - b[j].x) > 1e-4f || fabsf(a[j].y - b[j].y) > 1e-4f || fabsf(a[j].z - b[j].z) > 1e-4f)
+			return false;
+	}
+	return true;
+}
+
+static bool
+colors_are(sg_debug_draw_buffer const& buffer, const size_t first, const size_t length, const uint32_t color)
+{
+	for (size_t j = first; j < first + length; j++)
+		if (buffer.colors[j] != color)
+			return false;
+	return true;
+}
+
+void test_debug_draw_swap()
+{
+	sg_debug_draw draw;
+	sg_debug_draw_buffer frame;
+	CHECK(sg_success(sg_debug_draw_init(&draw, 1024, subdivisions, SG_DEBUG_DRAW_OVERFLOW_DROP, &allocator)),
+	      "could not initialize debug draw");
+
+	const sg_gizmo_sphere_info sphere{ 2.0f, SG_GIZMO_TOPOLOGY_LINE_LIST, subdivisions };
+	const size_t sphere_length = draw.cache.templates[SG_GIZMO_SHAPE_SPHERE].vertices_length;
+	CHECK(sg_success(sg_debug_draw_line(&draw, { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, 0xff0000ffu)),
+	      "could not draw line");
+	CHECK(sg_success(sg_debug_draw_sphere(&draw, &sphere, NULL, 0x00ff00ffu)), "could not draw sphere");
+
+	// The swapped out frame holds the requests made before the swap.
+	CHECK(sg_success(sg_debug_draw_swap(&draw, &frame)), "could not swap");
+	CHECK(frame.length == 2 + sphere_length && frame.dropped == 0, "wrong first frame length");
+	CHECK(frame.positions[0].x == 1.0f && frame.positions[0].y == 2.0f && frame.positions[0].z == 3.0f
+	      && frame.positions[1].x == 4.0f && frame.positions[1].y == 5.0f && frame.positions[1].z == 6.0f,
+	      "wrong line ends");
+	CHECK(colors_are(frame, 0, 2, 0xff0000ffu) && colors_are(frame, 2, sphere_length, 0x00ff00ffu),
+	      "wrong request colors");
+
+	// The next frame is built in the other buffer, starting empty.
+	sg_debug_draw_buffer const& back = draw.buffers[draw.back];
+	CHECK(back.positions != frame.positions && back.colors != frame.colors,
+	      "next frame built in the swapped out buffer");
+	CHECK(back.length == 0 && back.dropped == 0, "next frame does not start empty");
+
+	const sg_position* first_positions = frame.positions;
+	CHECK(sg_success(sg_debug_draw_line(&draw, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, 0x0000ffffu)),
+	      "could not draw line");
+	CHECK(sg_success(sg_debug_draw_swap(&draw, &frame)), "could not swap");
+	CHECK(frame.length == 2 && frame.positions != first_positions, "wrong second frame");
+	CHECK(draw.buffers[draw.back].positions == first_positions, "buffers not swapped back and forth");
+	CHECK(draw.buffers[draw.back].length == 0, "third frame does not start empty");
+
+	sg_debug_draw_free(&draw);
+}
+
+void test_debug_draw_overflow()
+{
+	const sg_gizmo_cube_info cube{ 1.0f, 1.0f, 1.0f, SG_GIZMO_TOPOLOGY_LINE_LIST };
+	const sg_position sentinel{ -7.0f, -7.0f, -7.0f };
+
+	for (const sg_debug_draw_overflow overflow : { SG_DEBUG_DRAW_OVERFLOW_DROP, SG_DEBUG_DRAW_OVERFLOW_ERROR }) {
+		sg_debug_draw draw;
+		sg_debug_draw_buffer frame;
+		CHECK(sg_success(sg_debug_draw_init(&draw, 30, subdivisions, overflow, &allocator)),
+		      "could not initialize debug draw");
+		const size_t cube_length = draw.cache.templates[SG_GIZMO_SHAPE_CUBE].vertices_length;
+		CHECK(cube_length == 24 && cube_length + 4 < draw.capacity, "unexpected cube length");
+
+		sg_debug_draw_buffer& back = draw.buffers[draw.back];
+		for (size_t j = 0; j < draw.capacity; j++)
+			back.positions[j] = sentinel;
+
+		CHECK(sg_success(sg_debug_draw_cube(&draw, &cube, NULL, 1u)), "could not draw cube");
+		CHECK(sg_success(sg_debug_draw_line(&draw, {}, { 1.0f, 0.0f, 0.0f }, 2u)), "could not draw line");
+
+		// A second cube does not fit whole in the 4 vertices left.
+		const sg_status status = sg_debug_draw_cube(&draw, &cube, NULL, 3u);
+		if (overflow == SG_DEBUG_DRAW_OVERFLOW_DROP)
+			CHECK(status == SG_OK_RETURNED_BUFFER && back.dropped == 1, "overflowing cube not dropped");
+		else
+			CHECK(status == SG_ERR_BUFFER_FULL && back.dropped == 0, "overflowing cube not rejected");
+		CHECK(back.length == cube_length + 2, "overflowing cube written");
+		for (size_t j = back.length; j < draw.capacity; j++)
+			CHECK(memcmp(&back.positions[j], &sentinel, sizeof(sentinel)) == 0, "overflowing cube written");
+
+		// Smaller requests still fit after it.
+		CHECK(sg_success(sg_debug_draw_line(&draw, {}, { 0.0f, 1.0f, 0.0f }, 4u)), "could not draw line");
+		CHECK(sg_success(sg_debug_draw_swap(&draw, &frame)), "could not swap");
+		CHECK(frame.length == cube_length + 4, "wrong frame length after overflow");
+		CHECK(frame.dropped == ((overflow == SG_DEBUG_DRAW_OVERFLOW_DROP) ? 1u : 0u), "wrong dropped count");
+		CHECK(colors_are(frame, cube_length + 2, 2, 4u), "request after overflow lost");
+
+		sg_debug_draw_free(&draw);
+	}
+}
+
+/* Gizmos drawn through a transform match the transformed gizmo generators. */
+void test_debug_draw_gizmos()
+{
+	sg_debug_draw draw;
+	sg_debug_draw_buffer frame;
+	CHECK(sg_success(sg_debug_draw_init(&draw, 4096, subdivisions, SG_DEBUG_DRAW_OVERFLOW_ERROR, &allocator)),
+	      "could not initialize debug draw");
+
+	sg_gizmo_cone_info cone{ 2.0f, 0.5f, SG_GIZMO_TOPOLOGY_LINE_LIST, subdivisions };
+	sg_gizmo_sphere_info sphere{ 1.5f, SG_GIZMO_TOPOLOGY_LINE_LIST, subdivisions };
+	sg_gizmo_cube_info cube{ 1.0f, 2.0f, 3.0f, SG_GIZMO_TOPOLOGY_LINE_LIST };
+	sg_gizmo_capsule_info capsule{ 3.0f, 1.0f, SG_GIZMO_TOPOLOGY_LINE_LIST, subdivisions };
+	const sg_mat3x4 transform = sg_mat3x4_from_trs({ 1.0f, -2.0f, 0.5f }, { 0.2f, 0.4f, 0.1f, 0.8888f },
+	                                               { 1.0f, 2.0f, 0.5f });
+
+	std::vector<sg_position> expected(4096);
+	size_t length = 0;
+	size_t n = 0;
+
+	CHECK(sg_success(sg_debug_draw_cone(&draw, &cone, &transform, 1u)), "could not draw cone");
+	sg_gizmo_cone_vertices_transformed(&cone, &transform, &length, NULL);
+	CHECK(sg_success(sg_gizmo_cone_vertices_transformed(&cone, &transform, &length, expected.data() + n)),
+	      "could not generate cone");
+	n += length;
+
+	CHECK(sg_success(sg_debug_draw_sphere(&draw, &sphere, &transform, 2u)), "could not draw sphere");
+	sg_gizmo_sphere_vertices_transformed(&sphere, &transform, &length, NULL);
+	CHECK(sg_success(sg_gizmo_sphere_vertices_transformed(&sphere, &transform, &length, expected.data() + n)),
+	      "could not generate sphere");
+	n += length;
+
+	CHECK(sg_success(sg_debug_draw_cube(&draw, &cube, &transform, 3u)), "could not draw cube");
+	sg_gizmo_cube_vertices_transformed(&cube, &transform, &length, NULL);
+	CHECK(sg_success(sg_gizmo_cube_vertices_transformed(&cube, &transform, &length, expected.data() + n)),
+	      "could not generate cube");
+	n += length;
+
+	CHECK(sg_success(sg_debug_draw_capsule(&draw, &capsule, &transform, 4u)), "could not draw capsule");
+	sg_gizmo_capsule_vertices_transformed(&capsule, &transform, &length, NULL);
+	CHECK(sg_success(sg_gizmo_capsule_vertices_transformed(&capsule, &transform, &length, expected.data() + n)),
+	      "could not generate capsule");
+	n += length;
+
+	CHECK(sg_success(sg_debug_draw_swap(&draw, &frame)), "could not swap");
+	CHECK(frame.length == n, "drawn gizmos differ in length from the generated ones");
+	CHECK(positions_close(frame.positions, expected.data(), n), "drawn gizmos differ from the generated ones");
+
+	sg_debug_draw_free(&draw);
+}
+
+int main()
+{
+	test_debug_draw_swap();
+	test_debug_draw_overflow();
+	test_debug_draw_gizmos();
+	return 0;
+}
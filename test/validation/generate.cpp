@@ -0,0 +1,86 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <initializer_list>
+
+/* Every single call entry point generates a complete mesh. */
+
+static const sg_allocator allocator = sg_default_allocator();
+
+void test_indexed_plane_generate()
+{
+	sg_indexed_plane_info plane{};
+	plane.width = 2.0f;
+	plane.depth = 3.0f;
+	plane.width_subdivisions = 5;
+	plane.depth_subdivisions = 3;
+
+	for (size_t cache_size : { 0, 16 }) {
+		sg_mesh mesh;
+		plane.cache_size = cache_size;
+		CHECK(sg_success(sg_indexed_plane_generate(&plane, SG_ATTRIBUTE_ALL, &allocator, &mesh)),
+		      "could not generate indexed plane");
+		CHECK(mesh.vertices_length == 15, "wrong indexed plane vertex count");
+		CHECK(mesh.indices_length == 4 * 2 * 6, "wrong indexed plane index count");
+		CHECK(indices_in_range(mesh), "indexed plane index out of range");
+		sg_mesh_free(&allocator, &mesh);
+	}
+}
+
+void test_cube_generate()
+{
+	sg_cube_info cube{ 1.0f, 2.0f, 3.0f };
+	sg_mesh mesh;
+	CHECK(sg_success(sg_cube_generate(&cube, SG_ATTRIBUTE_ALL, &allocator, &mesh)),
+	      "could not generate cube");
+	CHECK(mesh.vertices_length == 36 && mesh.indices_length == 0, "wrong cube lengths");
+	sg_mesh_free(&allocator, &mesh);
+}
+
+void test_indexed_cube_generate()
+{
+	sg_indexed_cube_info cube{ 1.0f, 2.0f, 3.0f, 3 };
+	sg_mesh mesh;
+	CHECK(sg_success(sg_indexed_cube_generate(&cube, SG_ATTRIBUTE_ALL, &allocator, &mesh)),
+	      "could not generate indexed cube");
+	CHECK(mesh.vertices_length == 6 * 16 && mesh.indices_length == 6 * 9 * 6, "wrong indexed cube lengths");
+	CHECK(indices_in_range(mesh), "indexed cube index out of range");
+	sg_mesh_free(&allocator, &mesh);
+}
+
+void test_indexed_sphere_generate()
+{
+	sg_indexed_sphere_info sphere{ 1.0f, 8, 3 };
+	sg_mesh mesh;
+	CHECK(sg_success(sg_indexed_sphere_generate(&sphere, SG_ATTRIBUTE_ALL, &allocator, &mesh)),
+	      "could not generate indexed sphere");
+	CHECK(mesh.vertices_length == 9 * 4 && mesh.indices_length == 8 * 3 * 6, "wrong indexed sphere lengths");
+	CHECK(indices_in_range(mesh), "indexed sphere index out of range");
+	sg_mesh_free(&allocator, &mesh);
+}
+
+void test_cylinder_generate()
+{
+	sg_cylinder_info cylinder{ 2.0f, 0.5f, 1.0f, 12, 3 };
+	sg_mesh mesh;
+	CHECK(sg_success(sg_cylinder_generate(&cylinder, SG_ATTRIBUTE_ALL, &allocator, &mesh)),
+	      "could not generate cylinder");
+	CHECK(mesh.vertices_length > 0 && mesh.indices_length == 0, "wrong cylinder lengths");
+	sg_mesh_free(&allocator, &mesh);
+
+	CHECK(sg_success(sg_indexed_cylinder_generate(&cylinder, SG_ATTRIBUTE_ALL, &allocator, &mesh)),
+	      "could not generate indexed cylinder");
+	CHECK(indices_in_range(mesh), "indexed cylinder index out of range");
+	sg_mesh_free(&allocator, &mesh);
+}
+
+int main()
+{
+	test_indexed_plane_generate();
+	test_cube_generate();
+	test_indexed_cube_generate();
+	test_indexed_sphere_generate();
+	test_cylinder_generate();
+	return 0;
+}
@@ -0,0 +1,51 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#define SG_indice uint16_t
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <vector>
+
+/* Baked strip indices of 16 bit never reach the strip restart index, bakes
+ * that would need them are rejected.
+ */
+
+static const sg_allocator allocator = sg_default_allocator();
+
+void test_gizmo_bake_index_range()
+{
+	sg_gizmo_cache cache;
+	CHECK(sg_success(sg_gizmo_cache_init(&cache, SG_GIZMO_TOPOLOGY_LINE_STRIP, 0, &allocator)),
+	      "could not initialize gizmo cache");
+
+	for (size_t shape = 0; shape < SG_GIZMO_SHAPE_COUNT; shape++) {
+		sg_mesh const& gizmo = cache.templates[shape];
+		const size_t fitting = SG_GIZMO_STRIP_RESTART / gizmo.vertices_length;
+		size_t length = 0;
+
+		CHECK(sg_gizmo_cache_bake_indices(&cache, (sg_gizmo_shape)shape, fitting + 1, &length, NULL)
+		      == SG_ERR_INVALID_RANGE,
+		      "gizmo bake past the strip restart index accepted");
+
+		CHECK(sg_gizmo_cache_bake_indices(&cache, (sg_gizmo_shape)shape, fitting, &length, NULL)
+		      == SG_OK_RETURNED_LENGTH,
+		      "could not query gizmo bake length");
+		std::vector<SG_indice> indices(length);
+		CHECK(sg_gizmo_cache_bake_indices(&cache, (sg_gizmo_shape)shape, fitting, &length, indices.data())
+		      == SG_OK_RETURNED_BUFFER,
+		      "could not bake gizmo indices");
+
+		// Restarts stay where the template has them, every other index is a vertex.
+		for (size_t i = 0; i < indices.size(); i++) {
+			const bool restart = gizmo.indices[i % gizmo.indices_length] == SG_GIZMO_STRIP_RESTART;
+			CHECK(restart == (indices[i] == SG_GIZMO_STRIP_RESTART), "gizmo bake strip restart moved");
+			CHECK(restart || indices[i] < fitting * gizmo.vertices_length, "gizmo bake index out of range");
+		}
+	}
+	sg_gizmo_cache_free(&cache);
+}
+
+int main()
+{
+	test_gizmo_bake_index_range();
+	return 0;
+}
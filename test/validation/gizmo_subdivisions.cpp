@@ -0,0 +1,78 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <cmath>
+
+/* Gizmo circles get the fewest subdivisions, as a multiple of 4 within
+ * [4, SG_GIZMO_CIRCLE_SUBDIVISIONS], keeping their segments within the
+ * requested distance of the circle.
+ */
+
+/* Largest distance between a circle of 'radius' and its 'subdivisions'
+ * segments.
+ */
+static double
+segment_error(const double radius, const size_t subdivisions)
+{
+	return radius * (1.0 - cos(M_PI / subdivisions));
+}
+
+void test_circle_subdivisions_bound()
+{
+	const float radii[] = { 1.5f, 3.0f, 10.0f, 37.0f, 100.0f, 333.0f, 1000.0f, 2500.0f };
+	const float errors[] = { 0.05f, 0.1f, 0.25f, 0.5f, 1.0f, 2.0f };
+	// The error bound is evaluated in float, allow for its rounding.
+	const double tolerance = 1e-3;
+
+	for (const float radius : radii) {
+		for (const float max_error : errors) {
+			const size_t subdivisions = sg_gizmo_circle_subdivisions(radius, max_error);
+			CHECK(subdivisions % 4 == 0, "circle subdivisions not a multiple of 4");
+			CHECK(subdivisions >= 4 && subdivisions <= SG_GIZMO_CIRCLE_SUBDIVISIONS,
+			      "circle subdivisions outside of [4, SG_GIZMO_CIRCLE_SUBDIVISIONS]");
+
+			// The bound holds, unless it needs more than the largest count.
+			if (subdivisions < SG_GIZMO_CIRCLE_SUBDIVISIONS)
+				CHECK(segment_error(radius, subdivisions) <= max_error * (1.0 + tolerance),
+				      "circle segments further from the circle than requested");
+			else
+				CHECK(segment_error(radius, SG_GIZMO_CIRCLE_SUBDIVISIONS - 4) > max_error * (1.0 - tolerance),
+				      "circle clamped to the largest count while fewer subdivisions would do");
+
+			// 4 subdivisions less would break the bound.
+			if (subdivisions > 4)
+				CHECK(segment_error(radius, subdivisions - 4) > max_error * (1.0 - tolerance),
+				      "circle subdivisions not the fewest multiple of 4");
+		}
+	}
+}
+
+void test_circle_subdivisions_limits()
+{
+	// No error bound falls back to the largest count.
+	CHECK(sg_gizmo_circle_subdivisions(100.0f, 0.0f) == SG_GIZMO_CIRCLE_SUBDIVISIONS,
+	      "zero error not given the largest count");
+	CHECK(sg_gizmo_circle_subdivisions(100.0f, -1.0f) == SG_GIZMO_CIRCLE_SUBDIVISIONS,
+	      "negative error not given the largest count");
+
+	// Circles no larger than the error are drawn as a square.
+	CHECK(sg_gizmo_circle_subdivisions(0.5f, 1.0f) == 4, "circle smaller than the error not a square");
+	CHECK(sg_gizmo_circle_subdivisions(1.0f, 1.0f) == 4, "circle as large as the error not a square");
+	CHECK(sg_gizmo_circle_subdivisions(0.0f, 0.5f) == 4, "empty circle not a square");
+
+	// Huge circles are clamped to the largest count.
+	CHECK(sg_gizmo_circle_subdivisions(1e6f, 0.5f) == SG_GIZMO_CIRCLE_SUBDIVISIONS,
+	      "huge circle not clamped to the largest count");
+
+	// Rounding up to a multiple of 4: a radius needing 5 segments gets 8.
+	const float radius = 0.5f / (1.0f - cosf(SG_PI / 5.0f));
+	CHECK(sg_gizmo_circle_subdivisions(radius, 0.5f) == 8, "5 segments not rounded up to 8");
+}
+
+int main()
+{
+	test_circle_subdivisions_bound();
+	test_circle_subdivisions_limits();
+	return 0;
+}
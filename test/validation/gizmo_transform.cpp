@@ -0,0 +1,162 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <cmath>
+#include <initializer_list>
+#include <vector>
+
+/* Transformed gizmos, generated or baked, are the untransformed ones passed
+ * through sg_mat3x4_transform_point(). Vertex counts that are not multiples
+ * of 4 run the scalar tail after the SIMD blocks of the affine kernel.
+ */
+
+static const sg_allocator allocator = sg_default_allocator();
+
+static const sg_mat3x4 transform = sg_mat3x4_from_trs({ 1.0f, -2.0f, 0.5f }, { 0.2f, 0.4f, 0.1f, 0.8888f },
+                                                      { 1.0f, 2.0f, 0.5f });
+
+static bool
+position_close(sg_position const& a, sg_vec3f const& b)
+{
+	return fabsf(a.x - b.x) <= 1e-5f * (1.0f + fabsf(b.x))
+	    && fabsf(a.y - b.y) <= 1e-5f * (1.0f + fabsf(b.y))
+	    && fabsf(a.z - b.z) <= 1e-5f * (1.0f + fabsf(b.z));
+}
+
+static bool
+transformed_close(std::vector<sg_position> const& untransformed, std::vector<sg_position> const& transformed)
+{
+	if (untransformed.size() != transformed.size())
+		return false;
+	for (size_t j = 0; j < untransformed.size(); j++) {
+		const sg_vec3f p = { untransformed[j].x, untransformed[j].y, untransformed[j].z };
+		if (!position_close(transformed[j], sg_mat3x4_transform_point(transform, p)))
+			return false;
+	}
+	return true;
+}
+
+/* The kernel at every count up to a few SIMD blocks, with a stretched
+ * instance and vertices on both sides of y = 0.
+ */
+void test_affine_kernel_tails()
+{
+	const size_t capacity = 19;
+	const sg_gizmo_instance instance{ { 0.5f, 1.0f, -1.5f }, { 2.0f, 0.5f, 3.0f }, 0.75f, 0u };
+	float src[capacity * 3];
+	float dst[capacity * 3];
+	for (size_t j = 0; j < capacity; j++) {
+		src[j * 3 + 0] = sinf(j * 1.3f);
+		src[j * 3 + 1] = (j & 1) ? -0.25f - 0.1f * j : 0.25f + 0.1f * j;
+		src[j * 3 + 2] = cosf(j * 0.7f);
+	}
+
+	for (size_t count = 0; count <= capacity; count++) {
+		sg_gizmo_affine_kernel(src, count, &instance, &transform, dst);
+		for (size_t j = 0; j < count; j++) {
+			const float y = src[j * 3 + 1];
+			const sg_vec3f placed = {
+				instance.center.x + instance.scale.x * src[j * 3 + 0],
+				instance.center.y + instance.scale.y * y + ((y < 0.0f) ? -instance.stretch : instance.stretch),
+				instance.center.z + instance.scale.z * src[j * 3 + 2],
+			};
+			const sg_position out = { dst[j * 3 + 0], dst[j * 3 + 1], dst[j * 3 + 2] };
+			CHECK(position_close(out, sg_mat3x4_transform_point(transform, placed)),
+			      "affine kernel differs from sg_mat3x4_transform_point");
+		}
+	}
+}
+
+/* Generate a gizmo with & without the transform through 'vertices'. */
+template<typename Info, typename Vertices, typename Transformed>
+static void
+check_transformed(Info& info, Vertices vertices, Transformed transformed, size_t* counts_mod_4)
+{
+	size_t length = 0;
+	CHECK(sg_success(vertices(&info, &length, nullptr)), "could not query gizmo length");
+	std::vector<sg_position> untransformed(length);
+	CHECK(sg_success(vertices(&info, &length, untransformed.data())), "could not generate gizmo");
+
+	size_t transformed_length = 0;
+	CHECK(sg_success(transformed(&info, &transform, &transformed_length, nullptr)),
+	      "could not query transformed gizmo length");
+	std::vector<sg_position> result(transformed_length);
+	CHECK(sg_success(transformed(&info, &transform, &transformed_length, result.data())),
+	      "could not generate transformed gizmo");
+
+	CHECK(transformed_close(untransformed, result), "transformed gizmo differs from sg_mat3x4_transform_point");
+	counts_mod_4[length % 4]++;
+}
+
+void test_vertices_transformed()
+{
+	size_t counts_mod_4[4] = {};
+
+	for (int t = SG_GIZMO_TOPOLOGY_TRIANGLES; t <= SG_GIZMO_TOPOLOGY_LINE_STRIP; t++) {
+		const sg_gizmo_topology topology = (sg_gizmo_topology)t;
+		for (const size_t subdivisions : { 5, 6, 7, 9 }) {
+			sg_gizmo_cone_info cone{ 2.0f, 0.5f, topology, subdivisions };
+			sg_gizmo_sphere_info sphere{ 1.5f, topology, subdivisions };
+			sg_gizmo_cube_info cube{ 1.0f, 2.0f, 3.0f, topology };
+			sg_gizmo_capsule_info capsule{ 3.0f, 1.0f, topology, subdivisions };
+			check_transformed(cone, sg_gizmo_cone_vertices, sg_gizmo_cone_vertices_transformed, counts_mod_4);
+			check_transformed(sphere, sg_gizmo_sphere_vertices, sg_gizmo_sphere_vertices_transformed, counts_mod_4);
+			check_transformed(cube, sg_gizmo_cube_vertices, sg_gizmo_cube_vertices_transformed, counts_mod_4);
+			check_transformed(capsule, sg_gizmo_capsule_vertices, sg_gizmo_capsule_vertices_transformed, counts_mod_4);
+		}
+	}
+	CHECK(counts_mod_4[1] > 0 && counts_mod_4[2] > 0 && counts_mod_4[3] > 0,
+	      "gizmo vertex counts do not cover every scalar tail length");
+}
+
+/* Baking through per instance transforms matches baking the instances &
+ * transforming the result, 3 instances per bake so tails land mid-buffer.
+ */
+void test_bake_transformed()
+{
+	const size_t instances_length = 3;
+	size_t counts_mod_4[4] = {};
+
+	for (int t = SG_GIZMO_TOPOLOGY_TRIANGLES; t <= SG_GIZMO_TOPOLOGY_LINE_STRIP; t++) {
+		for (const size_t subdivisions : { 5, 6, 7, 9 }) {
+			sg_gizmo_cache cache;
+			CHECK(sg_success(sg_gizmo_cache_init(&cache, (sg_gizmo_topology)t, subdivisions, &allocator)),
+			      "could not initialize gizmo cache");
+
+			for (int s = 0; s < SG_GIZMO_SHAPE_COUNT; s++) {
+				const sg_gizmo_shape shape = (sg_gizmo_shape)s;
+				std::vector<sg_gizmo_instance> instances(instances_length);
+				std::vector<sg_mat3x4> transforms(instances_length, transform);
+				for (size_t i = 0; i < instances_length; i++)
+					instances[i] = { { 1.0f * i, -0.5f * i, 0.25f }, { 1.0f + i, 0.5f, 2.0f }, 0.3f * i, 0u };
+
+				size_t length = 0;
+				CHECK(sg_success(sg_gizmo_cache_bake(&cache, shape, instances.data(), instances_length, &length, NULL)),
+				      "could not query bake length");
+				std::vector<sg_position> baked(length);
+				std::vector<sg_position> result(length);
+				CHECK(sg_success(sg_gizmo_cache_bake(&cache, shape, instances.data(), instances_length, &length,
+				                                     baked.data())),
+				      "could not bake gizmos");
+				CHECK(sg_success(sg_gizmo_cache_bake_transformed(&cache, shape, instances.data(), transforms.data(),
+				                                                 instances_length, &length, result.data())),
+				      "could not bake transformed gizmos");
+
+				CHECK(transformed_close(baked, result), "baked gizmo differs from sg_mat3x4_transform_point");
+				counts_mod_4[cache.templates[shape].vertices_length % 4]++;
+			}
+			sg_gizmo_cache_free(&cache);
+		}
+	}
+	CHECK(counts_mod_4[1] > 0 && counts_mod_4[2] > 0 && counts_mod_4[3] > 0,
+	      "gizmo template counts do not cover every scalar tail length");
+}
+
+int main()
+{
+	test_affine_kernel_tails();
+	test_vertices_transformed();
+	test_bake_transformed();
+	return 0;
+}
@@ -0,0 +1,129 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#define SIMPLE_GEOMETRY_USE_PTHREADS
+#define SG_indice uint16_t
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <initializer_list>
+
+/* With 16 bit indices, index generators accept the largest grids whose last
+ * vertex is 65535 and reject anything bigger, rather than truncating.
+ */
+
+static const sg_allocator allocator = sg_default_allocator();
+
+void test_plane_indice_range()
+{
+	sg_indexed_plane_info fits{ 1.0f, 1.0f, 256, 256, 16 };
+	sg_indexed_plane_info wide{ 1.0f, 1.0f, 257, 256, 16 };
+	sg_indexed_plane_info deep{ 1.0f, 1.0f, 2, 32769, 0 };
+	SG_indice row[6];
+	size_t length = 0;
+
+	sg_mesh mesh;
+	CHECK(sg_success(sg_indexed_plane_generate(&fits, SG_ATTRIBUTE_POSITION, &allocator, &mesh)),
+	      "plane within the index range rejected");
+	CHECK(indices_in_range(mesh), "plane index out of range");
+	sg_mesh_free(&allocator, &mesh);
+
+	for (auto const* plane : { &wide, &deep }) {
+		CHECK(sg_indexed_plane_indices(plane, &length, NULL) == SG_ERR_INVALID_RANGE,
+		      "plane past the index range accepted");
+		CHECK(sg_indexed_plane_indices_range(plane, 0, 1, row) == SG_ERR_INVALID_RANGE,
+		      "plane rows past the index range accepted");
+		CHECK(sg_indexed_plane_indices_parallel(plane, 4, &length, row) == SG_ERR_INVALID_RANGE,
+		      "parallel plane past the index range accepted");
+		CHECK(sg_indexed_plane_generate(plane, SG_ATTRIBUTE_POSITION, &allocator, &mesh) == SG_ERR_INVALID_RANGE,
+		      "generated plane past the index range accepted");
+	}
+}
+
+void test_sphere_indice_range()
+{
+	sg_indexed_sphere_info fits{ 1.0f, 255, 255 };
+	sg_indexed_sphere_info wide{ 1.0f, 255, 256 };
+	SG_indice row[6 * 256];
+	size_t length = 0;
+
+	sg_mesh mesh;
+	CHECK(sg_success(sg_indexed_sphere_generate(&fits, SG_ATTRIBUTE_POSITION, &allocator, &mesh)),
+	      "sphere within the index range rejected");
+	CHECK(indices_in_range(mesh), "sphere index out of range");
+	sg_mesh_free(&allocator, &mesh);
+
+	CHECK(sg_indexed_sphere_indices(&wide, &length, NULL) == SG_ERR_INVALID_RANGE,
+	      "sphere past the index range accepted");
+	CHECK(sg_indexed_sphere_indices_range(&wide, 0, 1, row) == SG_ERR_INVALID_RANGE,
+	      "sphere rows past the index range accepted");
+	CHECK(sg_indexed_sphere_indices_parallel(&wide, 4, &length, row) == SG_ERR_INVALID_RANGE,
+	      "parallel sphere past the index range accepted");
+	CHECK(sg_indexed_sphere_generate(&wide, SG_ATTRIBUTE_POSITION, &allocator, &mesh) == SG_ERR_INVALID_RANGE,
+	      "generated sphere past the index range accepted");
+}
+
+void test_terrain_tile_indice_range()
+{
+	// 255 quads a side give 256 * 256 grid vertices, which leave no room for
+	// the 4 * 256 skirt vertices.
+	sg_heightfield_info heightfield{};
+	heightfield.plane.width = 1.0f;
+	heightfield.plane.depth = 1.0f;
+	heightfield.plane.width_subdivisions = 256;
+	heightfield.plane.depth_subdivisions = 256;
+	sg_terrain_tile_info tile{ &heightfield, 255, 0, 0, 0, 0, 0.0f };
+	size_t length = 0;
+
+	CHECK(sg_terrain_tile_indices(&tile, &length, NULL) == SG_OK_RETURNED_LENGTH,
+	      "tile within the index range rejected");
+	tile.skirt_depth = 1.0f;
+	CHECK(sg_terrain_tile_indices(&tile, &length, NULL) == SG_ERR_INVALID_RANGE,
+	      "tile with skirts past the index range accepted");
+}
+
+void test_indexed_cube_indice_range()
+{
+	// 6 faces of 104 * 104 vertices end at vertex 64895, 105 * 105 would not fit.
+	sg_indexed_cube_info fits{ 1.0f, 1.0f, 1.0f, 103 };
+	sg_indexed_cube_info past{ 1.0f, 1.0f, 1.0f, 104 };
+	size_t length = 0;
+
+	sg_mesh mesh;
+	CHECK(sg_success(sg_indexed_cube_generate(&fits, SG_ATTRIBUTE_POSITION, &allocator, &mesh)),
+	      "indexed cube within the index range rejected");
+	CHECK(indices_in_range(mesh), "indexed cube index out of range");
+	sg_mesh_free(&allocator, &mesh);
+
+	CHECK(sg_indexed_cube_indices(&past, &length, NULL) == SG_ERR_INVALID_RANGE,
+	      "indexed cube past the index range accepted");
+	CHECK(sg_indexed_cube_generate(&past, SG_ATTRIBUTE_POSITION, &allocator, &mesh) == SG_ERR_INVALID_RANGE,
+	      "generated indexed cube past the index range accepted");
+}
+
+void test_indexed_cylinder_indice_range()
+{
+	// 256 rings of 256 vertices, caps included, end at vertex 65535.
+	sg_cylinder_info fits{ 1.0f, 1.0f, 1.0f, 255, 253 };
+	sg_cylinder_info past{ 1.0f, 1.0f, 1.0f, 255, 254 };
+	size_t length = 0;
+
+	sg_mesh mesh;
+	CHECK(sg_success(sg_indexed_cylinder_generate(&fits, SG_ATTRIBUTE_POSITION, &allocator, &mesh)),
+	      "indexed cylinder within the index range rejected");
+	CHECK(indices_in_range(mesh), "indexed cylinder index out of range");
+	sg_mesh_free(&allocator, &mesh);
+
+	CHECK(sg_indexed_cylinder_indices(&past, &length, NULL) == SG_ERR_INVALID_RANGE,
+	      "indexed cylinder past the index range accepted");
+	CHECK(sg_indexed_cylinder_generate(&past, SG_ATTRIBUTE_POSITION, &allocator, &mesh) == SG_ERR_INVALID_RANGE,
+	      "generated indexed cylinder past the index range accepted");
+}
+
+int main()
+{
+	test_plane_indice_range();
+	test_sphere_indice_range();
+	test_terrain_tile_indice_range();
+	test_indexed_cube_indice_range();
+	test_indexed_cylinder_indice_range();
+	return 0;
+}
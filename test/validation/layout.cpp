@@ -0,0 +1,122 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/* A packed vertex: float32 position, SNORM16 normal & UNORM16 texcoord,
+ * padded so every position stays 4 byte aligned.
+ */
+struct packed_vertex {
+	float position[3];
+	int16_t normal[3];
+	uint16_t texcoord[2];
+};
+static_assert(sizeof(packed_vertex) == 24, "unexpected packed vertex padding");
+
+static sg_vertex_layout
+packed_layout(packed_vertex* vertices)
+{
+	sg_vertex_layout layout;
+	layout.buffer = vertices;
+	layout.position = { SG_VERTEX_FORMAT_FLOAT32, offsetof(packed_vertex, position), sizeof(packed_vertex) };
+	layout.normal = { SG_VERTEX_FORMAT_SNORM16, offsetof(packed_vertex, normal), sizeof(packed_vertex) };
+	layout.texcoord = { SG_VERTEX_FORMAT_UNORM16, offsetof(packed_vertex, texcoord), sizeof(packed_vertex) };
+	return layout;
+}
+
+/* Generate through 'arrays' and through 'layout' into packed vertices, the
+ * packed vertices must hold the float32 arrays packed component by component.
+ */
+template<typename Arrays, typename Layout>
+static void
+check_packed(Arrays arrays, Layout layout_fn)
+{
+	size_t length = 0;
+	CHECK(arrays(&length, nullptr, nullptr, nullptr) == SG_OK_RETURNED_LENGTH, "could not query length");
+
+	std::vector<sg_position> positions(length);
+	std::vector<sg_normal> normals(length);
+	std::vector<sg_texcoord> texcoords(length);
+	CHECK(sg_success(arrays(&length, positions.data(), normals.data(), texcoords.data())),
+	      "could not generate float32 arrays");
+
+	std::vector<packed_vertex> vertices(length);
+	const sg_vertex_layout layout = packed_layout(vertices.data());
+	CHECK(sg_success(layout_fn(&length, &layout)), "could not generate packed layout");
+
+	for (size_t i = 0; i < length; i++) {
+		const float position[3] = { positions[i].x, positions[i].y, positions[i].z };
+		const int16_t normal[3] = {
+			sg_pack_snorm16(normals[i].x), sg_pack_snorm16(normals[i].y), sg_pack_snorm16(normals[i].z),
+		};
+		const uint16_t texcoord[2] = { sg_pack_unorm16(texcoords[i].u), sg_pack_unorm16(texcoords[i].v) };
+		CHECK(memcmp(vertices[i].position, position, sizeof(position)) == 0, "packed position differs");
+		CHECK(memcmp(vertices[i].normal, normal, sizeof(normal)) == 0, "packed normal differs");
+		CHECK(memcmp(vertices[i].texcoord, texcoord, sizeof(texcoord)) == 0, "packed texcoord differs");
+	}
+}
+
+void test_packed_layouts()
+{
+	sg_indexed_plane_info plane{ 2.0f, 3.0f, 7, 5, 0 };
+	check_packed(
+		[&](size_t* l, sg_position* p, sg_normal* n, sg_texcoord* t) { return sg_indexed_plane_vertices(&plane, l, p, n, t); },
+		[&](size_t* l, sg_vertex_layout const* layout) { return sg_indexed_plane_vertices_layout(&plane, l, layout); });
+
+	sg_indexed_sphere_info sphere{ 1.5f, 9, 13 };
+	check_packed(
+		[&](size_t* l, sg_position* p, sg_normal* n, sg_texcoord* t) { return sg_indexed_sphere_vertices(&sphere, l, p, n, t); },
+		[&](size_t* l, sg_vertex_layout const* layout) { return sg_indexed_sphere_vertices_layout(&sphere, l, layout); });
+
+	sg_indexed_cube_info cube{ 1.0f, 2.0f, 3.0f, 3 };
+	check_packed(
+		[&](size_t* l, sg_position* p, sg_normal* n, sg_texcoord* t) { return sg_indexed_cube_vertices(&cube, l, p, n, t); },
+		[&](size_t* l, sg_vertex_layout const* layout) { return sg_indexed_cube_vertices_layout(&cube, l, layout); });
+
+	sg_cylinder_info cylinder{ 2.0f, 0.5f, 1.0f, 11, 3 };
+	check_packed(
+		[&](size_t* l, sg_position* p, sg_normal* n, sg_texcoord* t) { return sg_cylinder_vertices(&cylinder, l, p, n, t); },
+		[&](size_t* l, sg_vertex_layout const* layout) { return sg_cylinder_vertices_layout(&cylinder, l, layout); });
+}
+
+/* Positions are not normalized, and attributes must be aligned to their
+ * component size.
+ */
+void test_rejected_layouts()
+{
+	sg_indexed_plane_info plane{ 1.0f, 1.0f, 4, 4, 0 };
+	size_t length = 0;
+	CHECK(sg_indexed_plane_vertices(&plane, &length, NULL, NULL, NULL) == SG_OK_RETURNED_LENGTH,
+	      "could not query plane length");
+
+	std::vector<packed_vertex> vertices(length + 1);
+	sg_vertex_layout layout = packed_layout(vertices.data());
+	layout.position.format = SG_VERTEX_FORMAT_SNORM16;
+	CHECK(sg_indexed_plane_vertices_layout(&plane, &length, &layout) == SG_ERR_INVALID_VERTEX_FORMAT,
+	      "SNORM16 positions accepted");
+
+	layout = packed_layout(vertices.data());
+	layout.position.stride = 22;
+	CHECK(sg_indexed_plane_vertices_layout(&plane, &length, &layout) == SG_ERR_UNALIGNED_VERTEX_ATTRIBUTE,
+	      "float32 positions on a 2 byte stride accepted");
+
+	layout = packed_layout(vertices.data());
+	layout.normal.offset += 1;
+	CHECK(sg_indexed_plane_vertices_layout(&plane, &length, &layout) == SG_ERR_UNALIGNED_VERTEX_ATTRIBUTE,
+	      "SNORM16 normals at an odd offset accepted");
+
+	layout = packed_layout(vertices.data());
+	layout.buffer = (unsigned char*)vertices.data() + 2;
+	CHECK(sg_indexed_plane_vertices_layout(&plane, &length, &layout) == SG_ERR_UNALIGNED_VERTEX_ATTRIBUTE,
+	      "float32 positions in a 2 byte aligned buffer accepted");
+}
+
+int main()
+{
+	test_packed_layouts();
+	test_rejected_layouts();
+	return 0;
+}
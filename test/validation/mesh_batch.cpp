@@ -0,0 +1,66 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#define SG_indice uint16_t
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+/* A batch of 16 bit indices rejects indexed primitives past index 65535. */
+
+static const sg_allocator allocator = sg_default_allocator();
+
+void test_batch_index_range()
+{
+	sg_mesh_batch batch;
+	sg_indexed_plane_info plane{};
+	plane.width = 1.0f;
+	plane.depth = 1.0f;
+	plane.width_subdivisions = 100;
+	plane.depth_subdivisions = 100;
+
+	CHECK(sg_success(sg_mesh_batch_init(&batch, SG_ATTRIBUTE_ALL, &allocator)),
+	      "could not initialize batch");
+
+	// 6 planes of 10000 vertices fit, the 7th would reach vertex 69999.
+	for (int i = 0; i < 6; i++)
+		CHECK(sg_success(sg_mesh_batch_add_indexed_plane(&batch, &plane, NULL)),
+		      "plane within the index range was rejected");
+
+	const size_t vertices_length = batch.mesh.vertices_length;
+	const size_t indices_length = batch.mesh.indices_length;
+	CHECK(sg_mesh_batch_add_indexed_plane(&batch, &plane, NULL) == SG_ERR_INVALID_RANGE,
+	      "plane past the index range was accepted");
+	CHECK(batch.mesh.vertices_length == vertices_length
+	      && batch.mesh.indices_length == indices_length
+	      && batch.submeshes_length == 6,
+	      "rejected plane changed the batch");
+
+	// A plane ending exactly on the last index still fits.
+	plane.depth_subdivisions = 2;
+	plane.width_subdivisions = (65536 - vertices_length) / 2;
+	CHECK(sg_success(sg_mesh_batch_add_indexed_plane(&batch, &plane, NULL)),
+	      "plane ending on the last index was rejected");
+	CHECK(batch.mesh.vertices_length == 65536, "plane did not end on the last index");
+
+	// Non-indexed primitives have no indices to overflow.
+	sg_cube_info cube{ 1.0f, 1.0f, 1.0f };
+	CHECK(sg_success(sg_mesh_batch_add_cube(&batch, &cube, NULL)),
+	      "cube was rejected");
+
+	CHECK(indices_in_range(batch.mesh), "batch index out of range");
+	for (size_t i = 0; i < batch.submeshes_length; i++) {
+		sg_submesh const& submesh = batch.submeshes[i];
+		for (size_t j = 0; j < submesh.indices_length; j++) {
+			const size_t index = batch.mesh.indices[submesh.indices_offset + j];
+			CHECK(index >= submesh.vertices_offset
+			      && index < submesh.vertices_offset + submesh.vertices_length,
+			      "index outside of its submesh");
+		}
+	}
+
+	sg_mesh_batch_free(&batch);
+}
+
+int main()
+{
+	test_batch_index_range();
+	return 0;
+}
@@ -0,0 +1,118 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#define SIMPLE_GEOMETRY_USE_PTHREADS
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <cstring>
+#include <vector>
+
+/* Rows are split across threads without changing what is written to them,
+ * so the parallel generators must match the serial ones bit for bit. Thread
+ * counts cover 0 & 1 (serial fallback), a few threads, and more threads
+ * than there are rows.
+ */
+
+template<typename T>
+static bool
+same_bits(std::vector<T> const& a, std::vector<T> const& b)
+{
+	return a.size() == b.size() && memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+/* Generate the vertices & indices of a generator through 'serial' and
+ * through 'parallel' with every thread count, comparing their bits.
+ */
+template<typename Vertices, typename Indices, typename VerticesParallel, typename IndicesParallel>
+static void
+check_parallel(
+	const size_t rows,
+	Vertices vertices,
+	Indices indices,
+	VerticesParallel vertices_parallel,
+	IndicesParallel indices_parallel
+)
+{
+	const size_t thread_counts[] = { 0, 1, 4, rows + 7 };
+	size_t vertices_length = 0;
+	size_t indices_length = 0;
+	CHECK(vertices(&vertices_length, nullptr, nullptr, nullptr) == SG_OK_RETURNED_LENGTH,
+	      "could not query vertex length");
+	CHECK(indices(&indices_length, nullptr) == SG_OK_RETURNED_LENGTH, "could not query index length");
+
+	std::vector<sg_position> positions(vertices_length);
+	std::vector<sg_normal> normals(vertices_length);
+	std::vector<sg_texcoord> texcoords(vertices_length);
+	std::vector<SG_indice> serial_indices(indices_length);
+	CHECK(sg_success(vertices(&vertices_length, positions.data(), normals.data(), texcoords.data())),
+	      "could not generate serial vertices");
+	CHECK(sg_success(indices(&indices_length, serial_indices.data())), "could not generate serial indices");
+
+	for (const size_t thread_count : thread_counts) {
+		size_t length = 0;
+		CHECK(vertices_parallel(thread_count, &length, nullptr, nullptr, nullptr) == SG_OK_RETURNED_LENGTH
+		      && length == vertices_length,
+		      "parallel vertex length differs");
+		CHECK(indices_parallel(thread_count, &length, nullptr) == SG_OK_RETURNED_LENGTH
+		      && length == indices_length,
+		      "parallel index length differs");
+
+		std::vector<sg_position> parallel_positions(vertices_length);
+		std::vector<sg_normal> parallel_normals(vertices_length);
+		std::vector<sg_texcoord> parallel_texcoords(vertices_length);
+		std::vector<SG_indice> parallel_indices(indices_length);
+		CHECK(vertices_parallel(thread_count, &length, parallel_positions.data(), parallel_normals.data(),
+		                        parallel_texcoords.data()) == SG_OK_RETURNED_BUFFER,
+		      "could not generate parallel vertices");
+		CHECK(indices_parallel(thread_count, &length, parallel_indices.data()) == SG_OK_RETURNED_BUFFER,
+		      "could not generate parallel indices");
+
+		CHECK(same_bits(positions, parallel_positions), "parallel positions differ");
+		CHECK(same_bits(normals, parallel_normals), "parallel normals differ");
+		CHECK(same_bits(texcoords, parallel_texcoords), "parallel texcoords differ");
+		CHECK(same_bits(serial_indices, parallel_indices), "parallel indices differ");
+	}
+}
+
+void test_sphere_parallel()
+{
+	const size_t grids[][2] = { { 3, 1 }, { 3, 8 }, { 16, 4 }, { 64, 33 }, { 7, 130 } };
+
+	for (auto const& grid : grids) {
+		sg_indexed_sphere_info sphere{ 1.0f, grid[1], grid[0] };
+		check_parallel(
+			sphere.stacks,
+			[&](size_t* l, sg_position* p, sg_normal* n, sg_texcoord* t) { return sg_indexed_sphere_vertices(&sphere, l, p, n, t); },
+			[&](size_t* l, SG_indice* i) { return sg_indexed_sphere_indices(&sphere, l, i); },
+			[&](size_t c, size_t* l, sg_position* p, sg_normal* n, sg_texcoord* t) {
+				return sg_indexed_sphere_vertices_parallel(&sphere, c, l, p, n, t);
+			},
+			[&](size_t c, size_t* l, SG_indice* i) { return sg_indexed_sphere_indices_parallel(&sphere, c, l, i); });
+	}
+}
+
+void test_plane_parallel()
+{
+	const size_t grids[][2] = { { 2, 2 }, { 7, 3 }, { 3, 7 }, { 65, 40 }, { 130, 9 } };
+	const size_t cache_sizes[] = { 0, 16, 32 };
+
+	for (auto const& grid : grids) {
+		for (const size_t cache_size : cache_sizes) {
+			sg_indexed_plane_info plane{ 2.0f, 3.0f, grid[0], grid[1], cache_size };
+			check_parallel(
+				plane.depth_subdivisions - 1,
+				[&](size_t* l, sg_position* p, sg_normal* n, sg_texcoord* t) { return sg_indexed_plane_vertices(&plane, l, p, n, t); },
+				[&](size_t* l, SG_indice* i) { return sg_indexed_plane_indices(&plane, l, i); },
+				[&](size_t c, size_t* l, sg_position* p, sg_normal* n, sg_texcoord* t) {
+					return sg_indexed_plane_vertices_parallel(&plane, c, l, p, n, t);
+				},
+				[&](size_t c, size_t* l, SG_indice* i) { return sg_indexed_plane_indices_parallel(&plane, c, l, i); });
+		}
+	}
+}
+
+int main()
+{
+	test_sphere_parallel();
+	test_plane_parallel();
+	return 0;
+}
@@ -0,0 +1,95 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <cstring>
+#include <vector>
+
+/* Average cache miss ratio, misses per triangle, of drawing 'indices' through
+ * a FIFO vertex cache of 'cache_size' entries.
+ */
+static double
+fifo_acmr(std::vector<SG_indice> const& indices, const size_t cache_size)
+{
+	std::vector<SG_indice> cache;
+	size_t next = 0;
+	size_t misses = 0;
+
+	for (const SG_indice index : indices) {
+		bool hit = false;
+		for (const SG_indice cached : cache)
+			hit |= (cached == index);
+		if (hit)
+			continue;
+
+		misses++;
+		if (cache.size() < cache_size) {
+			cache.push_back(index);
+		} else {
+			cache[next] = index;
+			next = (next + 1) % cache_size;
+		}
+	}
+	return misses / (indices.size() / 3.0);
+}
+
+/* Cache ordered indices of a 256x256 quad grid reach an ACMR of about 0.54
+ * with a 32 entry FIFO and 0.52 with 64 entries, against 1.0 for row order.
+ */
+void test_plane_cache_order()
+{
+	const struct {
+		size_t cache_size;
+		double acmr;
+	} expected[] = {
+		{ 0, 1.01 }, { 32, 0.55 }, { 64, 0.53 },
+	};
+
+	for (auto const& e : expected) {
+		sg_indexed_plane_info plane{ 1.0f, 1.0f, 257, 257, e.cache_size };
+		size_t length = 0;
+		CHECK(sg_indexed_plane_indices(&plane, &length, NULL) == SG_OK_RETURNED_LENGTH,
+		      "could not query plane index length");
+
+		std::vector<SG_indice> indices(length);
+		CHECK(sg_indexed_plane_indices(&plane, &length, indices.data()) == SG_OK_RETURNED_BUFFER,
+		      "could not generate plane indices");
+
+		const size_t measured_cache = (e.cache_size == 0) ? 32 : e.cache_size;
+		CHECK(fifo_acmr(indices, measured_cache) < e.acmr, "plane ACMR above the documented one");
+	}
+}
+
+/* Ranges of rows put together write the same indices, in either order. */
+void test_plane_index_rows()
+{
+	const size_t grids[][2] = { { 2, 2 }, { 5, 3 }, { 3, 9 }, { 70, 6 } };
+
+	for (auto const& grid : grids) {
+		for (const size_t cache_size : { 0, 7, 16 }) {
+			sg_indexed_plane_info plane{ 1.0f, 1.0f, grid[0], grid[1], cache_size };
+			size_t length = 0;
+			CHECK(sg_indexed_plane_indices(&plane, &length, NULL) == SG_OK_RETURNED_LENGTH,
+			      "could not query plane index length");
+
+			std::vector<SG_indice> full(length);
+			std::vector<SG_indice> rows(length);
+			CHECK(sg_indexed_plane_indices(&plane, &length, full.data()) == SG_OK_RETURNED_BUFFER,
+			      "could not generate plane indices");
+			for (size_t d = 0; d + 1 < plane.depth_subdivisions; d++)
+				CHECK(sg_indexed_plane_indices_range(&plane, d, d + 1, rows.data()) == SG_OK_RETURNED_BUFFER,
+				      "could not generate plane index row");
+			CHECK(sg_indexed_plane_indices_range(&plane, 0, plane.depth_subdivisions, rows.data()) == SG_ERR_INVALID_RANGE,
+			      "plane index rows past the last quad row accepted");
+			CHECK(memcmp(full.data(), rows.data(), length * sizeof(SG_indice)) == 0,
+			      "plane index rows differ from the full indices");
+		}
+	}
+}
+
+int main()
+{
+	test_plane_cache_order();
+	test_plane_index_rows();
+	return 0;
+}
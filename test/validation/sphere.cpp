@@ -0,0 +1,146 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/* Largest distance, per component, of a generated unit sphere vertex from the
+ * exact sphere. Trig is tabulated per slice & per stack, so vertices are not
+ * bit-identical to evaluating every vertex on its own; this is how far off
+ * they are allowed to be.
+ */
+static const double sphere_bound = 5e-7;
+
+void test_sphere_bound()
+{
+	const size_t grids[][2] = {
+		{ 3, 8 }, { 16, 4 }, { 64, 64 }, { 512, 512 }, { 2048, 2048 }, { 7, 1000 }, { 1000, 7 },
+	};
+
+	for (auto const& grid : grids) {
+		sg_indexed_sphere_info sphere{ 1.0f, grid[1], grid[0] };
+		size_t length = 0;
+		CHECK(sg_indexed_sphere_vertices(&sphere, &length, NULL, NULL, NULL) == SG_OK_RETURNED_LENGTH,
+		      "could not query sphere length");
+
+		std::vector<sg_position> positions(length);
+		std::vector<sg_normal> normals(length);
+		std::vector<sg_texcoord> texcoords(length);
+		CHECK(sg_success(sg_indexed_sphere_vertices(&sphere, &length, positions.data(),
+		                                            normals.data(), texcoords.data())),
+		      "could not generate sphere");
+
+		double error = 0.0;
+		size_t n = 0;
+		for (size_t i = 0; i <= sphere.stacks; i++) {
+			const double phi = M_PI * i / sphere.stacks;
+			for (size_t j = 0; j <= sphere.slices; j++, n++) {
+				const double theta = 2 * M_PI * j / sphere.slices;
+				const double x = cos(theta) * sin(phi);
+				const double y = cos(phi);
+				const double z = sin(theta) * sin(phi);
+
+				error = fmax(error, fabs(positions[n].x - x));
+				error = fmax(error, fabs(positions[n].y - y));
+				error = fmax(error, fabs(positions[n].z - z));
+				error = fmax(error, fabs(normals[n].x - x));
+				error = fmax(error, fabs(normals[n].y - y));
+				error = fmax(error, fabs(normals[n].z - z));
+				CHECK(texcoords[n].u == j / (float)sphere.slices
+				      && texcoords[n].v == i / (float)sphere.stacks,
+				      "wrong sphere texcoord");
+			}
+		}
+		CHECK(error < sphere_bound, "sphere vertex off the exact sphere");
+	}
+}
+
+/* The SIMD paths of the row kernel only multiply, like its scalar tail, so
+ * they must match a scalar loop bit for bit at every count & alignment.
+ */
+void test_sphere_row_kernel()
+{
+	const size_t capacity = 2 * SG_SPHERE_ROW_TILE + 8;
+	float slice_cos[capacity];
+	float slice_sin[capacity];
+	for (size_t j = 0; j < capacity; j++) {
+		slice_cos[j] = SG_COS(j * 0.37f);
+		slice_sin[j] = SG_SIN(j * 0.37f);
+	}
+
+	for (size_t offset = 0; offset < 4; offset++) {
+		for (size_t count = 0; offset + count <= capacity; count++) {
+			const float sin_phi = 0.8f;
+			const float radius = 3.3f;
+			float normals_x[capacity], normals_z[capacity];
+			float positions_x[capacity], positions_z[capacity];
+			sg_indexed_sphere_row_kernel(slice_cos + offset, slice_sin + offset, count,
+			                             sin_phi, radius,
+			                             normals_x, normals_z, positions_x, positions_z);
+
+			for (size_t j = 0; j < count; j++) {
+				const float x = slice_cos[offset + j] * sin_phi;
+				const float z = slice_sin[offset + j] * sin_phi;
+				const float expected[4] = { x, z, x * radius, z * radius };
+				const float actual[4] = { normals_x[j], normals_z[j], positions_x[j], positions_z[j] };
+				CHECK(memcmp(expected, actual, sizeof(expected)) == 0,
+				      "sphere row kernel differs from the scalar loop");
+			}
+		}
+	}
+}
+
+/* Index rows join vertex rows of 'slices + 1' vertices, 'stacks' of them,
+ * on grids that are not square as well.
+ */
+void test_sphere_indices()
+{
+	const sg_allocator allocator = sg_default_allocator();
+	const size_t grids[][2] = {
+		{ 1, 3 }, { 3, 8 }, { 3, 12 }, { 16, 4 }, { 5, 5 },
+	};
+
+	for (auto const& grid : grids) {
+		sg_indexed_sphere_info sphere{ 1.0f, grid[1], grid[0] };
+		sg_mesh mesh;
+		CHECK(sg_success(sg_indexed_sphere_generate(&sphere, SG_ATTRIBUTE_ALL, &allocator, &mesh)),
+		      "could not generate sphere");
+		CHECK(mesh.vertices_length == (sphere.slices + 1) * (sphere.stacks + 1),
+		      "wrong sphere vertex count");
+		CHECK(mesh.indices_length == sphere.slices * sphere.stacks * 6, "wrong sphere index count");
+		CHECK(indices_in_range(mesh), "sphere index out of range");
+
+		// Every triangle spans two neighbouring vertex rows.
+		for (size_t i = 0; i < mesh.indices_length; i += 3) {
+			const size_t rows[3] = {
+				mesh.indices[i] / (sphere.slices + 1),
+				mesh.indices[i + 1] / (sphere.slices + 1),
+				mesh.indices[i + 2] / (sphere.slices + 1),
+			};
+			const size_t row = i / (sphere.slices * 6);
+			for (size_t k = 0; k < 3; k++)
+				CHECK(rows[k] == row || rows[k] == row + 1, "sphere triangle spans the wrong rows");
+		}
+
+		// Ranges of rows put together write the same indices.
+		std::vector<SG_indice> indices(mesh.indices_length);
+		for (size_t i = 0; i < sphere.stacks; i++)
+			CHECK(sg_indexed_sphere_indices_range(&sphere, i, i + 1, indices.data()) == SG_OK_RETURNED_BUFFER,
+			      "could not generate sphere index row");
+		CHECK(sg_indexed_sphere_indices_range(&sphere, 0, sphere.stacks + 1, indices.data()) == SG_ERR_INVALID_RANGE,
+		      "sphere index rows past the last stack accepted");
+		CHECK(memcmp(indices.data(), mesh.indices, mesh.indices_length * sizeof(SG_indice)) == 0,
+		      "sphere index rows differ from the full indices");
+		sg_mesh_free(&allocator, &mesh);
+	}
+}
+
+int main()
+{
+	test_sphere_bound();
+	test_sphere_row_kernel();
+	test_sphere_indices();
+	return 0;
+}
@@ -0,0 +1,191 @@
+#define SIMPLE_GEOMETRY_IMPLEMENTATION
+#include "../../simple_geometry.h"
+#include "validation.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/* Tiles are windows of the heightfield, every tile vertex that is not moved
+ * by stitching is the heightfield vertex at the same grid position, at any
+ * lod, from a height array as well as from a sample callback.
+ */
+
+static float
+sample_height(size_t w, size_t d, void*)
+{
+	return sinf(w * 0.37f) * cosf(d * 0.21f) + 0.01f * w;
+}
+
+void test_terrain_tile_window()
+{
+	std::vector<float> heights(65 * 33);
+	for (size_t i = 0; i < heights.size(); i++)
+		heights[i] = sample_height(i % 65, i / 65, NULL);
+
+	for (int callback = 0; callback < 2; callback++) {
+		sg_heightfield_info heightfield{};
+		heightfield.plane.width = 6.0f;
+		heightfield.plane.depth = 3.5f;
+		heightfield.plane.width_subdivisions = 65;
+		heightfield.plane.depth_subdivisions = 33;
+		heightfield.heights = callback ? NULL : heights.data();
+		heightfield.sample = callback ? sample_height : NULL;
+		heightfield.height_scale = 1.5f;
+
+		size_t length = 0;
+		sg_heightfield_vertices(&heightfield, &length, NULL, NULL, NULL);
+		std::vector<sg_position> positions(length);
+		std::vector<sg_normal> normals(length);
+		std::vector<sg_texcoord> texcoords(length);
+		CHECK(sg_success(sg_heightfield_vertices(&heightfield, &length, positions.data(),
+		                                         normals.data(), texcoords.data())),
+		      "could not generate heightfield");
+
+		for (size_t lod = 0; lod < 4; lod++) {
+			for (size_t tile_y = 0; tile_y < 2; tile_y++) {
+				for (size_t tile_x = 0; tile_x < 4; tile_x++) {
+					sg_terrain_tile_info tile{ &heightfield, 16, tile_x, tile_y, lod,
+					                           SG_TILE_EDGE_SOUTH | SG_TILE_EDGE_EAST, 0.5f };
+					size_t tile_length = 0;
+					CHECK(sg_terrain_tile_vertices(&tile, &tile_length, NULL, NULL, NULL) == SG_OK_RETURNED_LENGTH,
+					      "could not query tile length");
+					std::vector<sg_position> tile_positions(tile_length);
+					std::vector<sg_normal> tile_normals(tile_length);
+					std::vector<sg_texcoord> tile_texcoords(tile_length);
+					CHECK(sg_success(sg_terrain_tile_vertices(&tile, &tile_length, tile_positions.data(),
+					                                          tile_normals.data(), tile_texcoords.data())),
+					      "could not generate tile");
+
+					const size_t step = (size_t)1 << lod;
+					const size_t quads = 16 / step;
+					for (size_t j = 0; j <= quads; j++) {
+						for (size_t i = 0; i <= quads; i++) {
+							const bool stitched = ((i & 1) && j == 0) || ((j & 1) && i == quads);
+							if (stitched)
+								continue;
+							const size_t n = j * (quads + 1) + i;
+							const size_t grid = (tile_y * 16 + j * step) * 65 + tile_x * 16 + i * step;
+							CHECK(memcmp(&tile_positions[n], &positions[grid], sizeof(sg_position)) == 0
+							      && memcmp(&tile_normals[n], &normals[grid], sizeof(sg_normal)) == 0
+							      && memcmp(&tile_texcoords[n], &texcoords[grid], sizeof(sg_texcoord)) == 0,
+							      "tile vertex differs from the heightfield vertex");
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+/* Stitched edge vertices lie halfway between their even neighbours, skirt
+ * vertices are their edge vertex lowered by 'skirt_depth', every index
+ * refers to a tile vertex and the skirt walls face away from the tile.
+ */
+void test_terrain_tile_edges()
+{
+	const unsigned int stitches[] = {
+		SG_TILE_EDGE_SOUTH | SG_TILE_EDGE_EAST, SG_TILE_EDGE_NORTH | SG_TILE_EDGE_WEST,
+	};
+	// Order of the stitched & skirt edges in a tile: south, north, west, east.
+	const unsigned int edges[4] = {
+		SG_TILE_EDGE_SOUTH, SG_TILE_EDGE_NORTH, SG_TILE_EDGE_WEST, SG_TILE_EDGE_EAST,
+	};
+	const float outwards[4][2] = { { 0.0f, -1.0f }, { 0.0f, 1.0f }, { -1.0f, 0.0f }, { 1.0f, 0.0f } };
+	const float skirt_depth = 0.5f;
+
+	sg_heightfield_info heightfield{};
+	heightfield.plane.width = 6.0f;
+	heightfield.plane.depth = 3.5f;
+	heightfield.plane.width_subdivisions = 65;
+	heightfield.plane.depth_subdivisions = 33;
+	heightfield.sample = sample_height;
+	heightfield.height_scale = 1.5f;
+
+	for (const unsigned int stitch : stitches) {
+		for (size_t lod = 0; lod < 4; lod++) {
+			sg_terrain_tile_info tile{ &heightfield, 16, 1, 1, lod, stitch, skirt_depth };
+			const size_t quads = 16 >> lod;
+			const size_t side = quads + 1;
+
+			size_t tile_length = 0;
+			CHECK(sg_terrain_tile_vertices(&tile, &tile_length, NULL, NULL, NULL) == SG_OK_RETURNED_LENGTH,
+			      "could not query tile length");
+			CHECK(tile_length == side * side + 4 * side, "wrong tile vertex count");
+			std::vector<sg_position> positions(tile_length);
+			std::vector<sg_normal> normals(tile_length);
+			std::vector<sg_texcoord> texcoords(tile_length);
+			CHECK(sg_success(sg_terrain_tile_vertices(&tile, &tile_length, positions.data(),
+			                                          normals.data(), texcoords.data())),
+			      "could not generate tile");
+
+			for (size_t edge = 0; edge < 4; edge++) {
+				const size_t first = (edge == 0) ? 0
+					: (edge == 1) ? quads * side
+					: (edge == 2) ? 0
+					: quads;
+				const size_t along = (edge < 2) ? 1 : side;
+
+				for (size_t k = 1; (stitch & edges[edge]) && k < quads; k += 2) {
+					const size_t n = first + k * along;
+					const size_t n0 = n - along;
+					const size_t n1 = n + along;
+					CHECK(positions[n].x == (positions[n0].x + positions[n1].x) * 0.5f
+					      && positions[n].y == (positions[n0].y + positions[n1].y) * 0.5f
+					      && positions[n].z == (positions[n0].z + positions[n1].z) * 0.5f,
+					      "stitched vertex is not the midpoint of its neighbours");
+					CHECK(texcoords[n].u == (texcoords[n0].u + texcoords[n1].u) * 0.5f
+					      && texcoords[n].v == (texcoords[n0].v + texcoords[n1].v) * 0.5f,
+					      "stitched texcoord is not the midpoint of its neighbours");
+					CHECK(fabsf(normals[n].x * normals[n].x + normals[n].y * normals[n].y
+					            + normals[n].z * normals[n].z - 1.0f) < 1e-5f,
+					      "stitched normal is not unit length");
+				}
+
+				for (size_t k = 0; k < side; k++) {
+					const size_t source = first + k * along;
+					const size_t skirt = side * side + edge * side + k;
+					CHECK(positions[skirt].x == positions[source].x
+					      && positions[skirt].y == positions[source].y
+					      && positions[skirt].z == positions[source].z - skirt_depth,
+					      "skirt vertex is not its edge vertex lowered by the skirt depth");
+					CHECK(memcmp(&normals[skirt], &normals[source], sizeof(sg_normal)) == 0
+					      && memcmp(&texcoords[skirt], &texcoords[source], sizeof(sg_texcoord)) == 0,
+					      "skirt vertex attributes differ from its edge vertex");
+				}
+			}
+
+			size_t indices_length = 0;
+			CHECK(sg_terrain_tile_indices(&tile, &indices_length, NULL) == SG_OK_RETURNED_LENGTH,
+			      "could not query tile index length");
+			CHECK(indices_length == quads * quads * 6 + 4 * quads * 6, "wrong tile index count");
+			std::vector<SG_indice> indices(indices_length);
+			CHECK(sg_success(sg_terrain_tile_indices(&tile, &indices_length, indices.data())),
+			      "could not generate tile indices");
+			for (const SG_indice index : indices)
+				CHECK(index < tile_length, "tile index out of range");
+
+			// The walls are vertical, their normal must point along the outward
+			// direction of their edge.
+			for (size_t i = quads * quads * 6; i < indices_length; i += 3) {
+				const size_t edge = (i - quads * quads * 6) / (quads * 6);
+				sg_position const& a = positions[indices[i]];
+				sg_position const& b = positions[indices[i + 1]];
+				sg_position const& c = positions[indices[i + 2]];
+				const float ab[3] = { b.x - a.x, b.y - a.y, b.z - a.z };
+				const float ac[3] = { c.x - a.x, c.y - a.y, c.z - a.z };
+				const float normal_x = ab[1] * ac[2] - ab[2] * ac[1];
+				const float normal_y = ab[2] * ac[0] - ab[0] * ac[2];
+				CHECK(normal_x * outwards[edge][0] + normal_y * outwards[edge][1] > 0.0f,
+				      "skirt triangle faces into the tile");
+			}
+		}
+	}
+}
+
+int main()
+{
+	test_terrain_tile_window();
+	test_terrain_tile_edges();
+	return 0;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+/* Checks stay on in every build type, unlike assert(). */
+#define CHECK(CONDITION, MESSAGE)                                           \
+	do {                                                                    \
+		if (!(CONDITION)) {                                                 \
+			fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, (MESSAGE)); \
+			exit(1);                                                        \
+		}                                                                   \
+	} while (0)
+
+/* Every index of 'mesh' refers to one of its vertices. */
+inline bool
+indices_in_range(sg_mesh const& mesh)
+{
+	for (size_t i = 0; i < mesh.indices_length; i++)
+		if (mesh.indices[i] >= mesh.vertices_length)
+			return false;
+	return true;
+}
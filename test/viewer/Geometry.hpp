@@ -151,32 +151,25 @@ std::vector<VertexPosNorm> create_cube()
 
 	std::vector<VertexPosNorm> vertices(positions.size());
 
-	sg_strided_blockcopy_source_info positions_copy;
-	positions_copy.ptr = positions.data();
-	positions_copy.block_size = sizeof(positions[0]);
-	positions_copy.stride = sizeof(positions[0]);
-	positions_copy.block_count = positions.size();
-	
-	status = sg_strided_blockcopy(&positions_copy,
-								  sizeof(vertices[0]),
-								  vertices.data());
-
-	if (status != SG_OK_COPIED_TO_DST)
-		throw std::runtime_error("Could not copy positions to vertices");
-
-	sg_strided_blockcopy_source_info normals_copy;
-	normals_copy.ptr = normals.data();
-	normals_copy.block_size = sizeof(normals[0]);
-	normals_copy.stride = sizeof(normals[0]);
-	normals_copy.block_count = normals.size();
-
-	status = sg_strided_blockcopy(&normals_copy,
-								  sizeof(vertices[0]),
-								  reinterpret_cast<char*>(vertices.data()) 
-								  + sizeof(vertices[0].pos));
+	sg_interleave_source_info sources[2];
+	sources[0].ptr = positions.data();
+	sources[0].block_size = sizeof(positions[0]);
+	sources[0].stride = sizeof(positions[0]);
+	sources[0].offset = offsetof(VertexPosNorm, pos);
+
+	sources[1].ptr = normals.data();
+	sources[1].block_size = sizeof(normals[0]);
+	sources[1].stride = sizeof(normals[0]);
+	sources[1].offset = offsetof(VertexPosNorm, norm);
+
+	status = sg_interleave(sources,
+						   2,
+						   vertices.size(),
+						   sizeof(vertices[0]),
+						   vertices.data());
 
 	if (status != SG_OK_COPIED_TO_DST)
-		throw std::runtime_error("Could not copy positions to vertices");
+		throw std::runtime_error("Could not interleave vertices");
 
 	return vertices;
 }
@@ -209,32 +202,25 @@ std::vector<VertexPosNorm> create_cylinder()
 
 	std::vector<VertexPosNorm> vertices(positions.size());
 
-	sg_strided_blockcopy_source_info positions_copy;
-	positions_copy.ptr = positions.data();
-	positions_copy.block_size = sizeof(positions[0]);
-	positions_copy.stride = sizeof(positions[0]);
-	positions_copy.block_count = positions.size();
-	
-	status = sg_strided_blockcopy(&positions_copy,
-								  sizeof(vertices[0]),
-								  vertices.data());
+	sg_interleave_source_info sources[2];
+	sources[0].ptr = positions.data();
+	sources[0].block_size = sizeof(positions[0]);
+	sources[0].stride = sizeof(positions[0]);
+	sources[0].offset = offsetof(VertexPosNorm, pos);
 
-	if (status != SG_OK_COPIED_TO_DST)
-		throw std::runtime_error("Could not copy positions to vertices");
+	sources[1].ptr = normals.data();
+	sources[1].block_size = sizeof(normals[0]);
+	sources[1].stride = sizeof(normals[0]);
+	sources[1].offset = offsetof(VertexPosNorm, norm);
 
-	sg_strided_blockcopy_source_info normals_copy;
-	normals_copy.ptr = normals.data();
-	normals_copy.block_size = sizeof(normals[0]);
-	normals_copy.stride = sizeof(normals[0]);
-	normals_copy.block_count = normals.size();
-
-	status = sg_strided_blockcopy(&normals_copy,
-								  sizeof(vertices[0]),
-								  reinterpret_cast<char*>(vertices.data()) 
-								  + sizeof(vertices[0].pos));
+	status = sg_interleave(sources,
+						   2,
+						   vertices.size(),
+						   sizeof(vertices[0]),
+						   vertices.data());
 
 	if (status != SG_OK_COPIED_TO_DST)
-		throw std::runtime_error("Could not copy positions to vertices");
+		throw std::runtime_error("Could not interleave vertices");
 
 	return vertices;
 }